@@ -15,33 +15,51 @@
 //#include <stdlib.h>
 
 #include "../HAL/BUZZER/BUZZER_interface.h"
+#include "../HAL/ENCODER/ENCODER_interface.h"
 #include "../HAL/KEYPAD/KEYPAD_interface.h"
 #include "../HAL/LCD/LCD_interface.h"
 #include "../HAL/LM35/LM35_interface.h"
 #include "../HAL/TIMER_manager/TIMER_manger_interface.h"
+#include "../MCAL/AVR_ARCH/DELAY_interface.h"
+#include "../MCAL/AVR_ARCH/ISR_interface.h"
+#include "../MCAL/AVR_ARCH/SLEEP_interface.h"
 
 #define APP_DELAY_1_S				2 /**< Delay in seconds */
 #define APP_DELAY_0_5_S				1  /**< Delay in half seconds */
 
 
-
-/* To get first digit of number by division */
-#define APP_SELECT_TENS_DIGIT				10
-
-/* Value of zero in char */
-#define APP_0_CHAR							'0'
-
-/* NULL termination during the loop on string */
-#define APP_NULL_TERMINATION_STRING			'\0'
-#define APP_TEMP_STRING_SIZE		5 /**< Size of the temperature string buffer */
 #define APP_TIMER_1_INIT_VALUE		61448
 #define APP_RESET_BTN				'5' /**< Reset button value */
 #define APP_ADJUST_BTN				'4' /**< Adjust button value */
 #define APP_INCREMENT_BTN			'1' /**< Increment button value */
 #define APP_DECREMENT_BTN			'2' /**< Decrement button value */
 #define APP_SET_BTN					'3' /**< Set button value */
+#define APP_DEBUG_BTN				'0' /**< Keypad timing screen button, with KEYPAD_INSTRUMENTATION */
 #define APP_NO_BTN					78  /**< No button value */
 
+#define APP_TEMP_FRAC_BITS			1   /**< The setpoint is kept in Q7.1, half a degree per step */
+#define APP_TEMP_STEPS_PER_DEGREE	(1 << APP_TEMP_FRAC_BITS) /**< Setpoint steps per degree */
+#define APP_TEMP_MIN				(18 * APP_TEMP_STEPS_PER_DEGREE) /**< Lowest setpoint, in half degrees */
+#define APP_TEMP_MAX				(35 * APP_TEMP_STEPS_PER_DEGREE) /**< Highest setpoint, in half degrees */
+#define APP_READING_FRAC_BITS		LM35_TEMP_FRAC_BITS /**< Sensor readings are kept in Q8.8 */
+#define APP_SETPOINT_TO_READING(SETPOINT)	((sint16_t)((sint16_t)(SETPOINT) << (APP_READING_FRAC_BITS - APP_TEMP_FRAC_BITS))) /**< Setpoint in the fixed-point format of the readings */
+#define APP_FILTER_STAGES			3   /**< Stages of the reading filter: median, moving average, IIR */
+#define APP_FILTER_MEDIAN			FILTER_MEDIAN_5 /**< Median length, a single wild sample never reaches the average */
+#define APP_FILTER_AVG_BITS			4   /**< Moving average of 16 readings, about 50 ms at 300 readings per second */
+#define APP_FILTER_IIR_SHIFT		5   /**< IIR coefficient 1/32, a time constant of about 0.1 s */
+#define APP_TEMP_DECIMALS			1   /**< Digits shown after the decimal point */
+#define APP_TEMP_FIELD_WIDTH		4   /**< Characters of a temperature readout, e.g. "23.7" */
+#define APP_SET_BAR_STEPS			(LCD_COLS_MAX * LCD_BAR_STEPS_PER_CELL) /**< Sub-steps of the setpoint bar */
+#define APP_NOTICE_STEP_MS			250 /**< Scroll period of the invalid-key notice */
+#define APP_REPEAT_FAST_COUNT		8   /**< Auto-repeats of a held key after which the setpoint moves a whole degree per repeat */
+#define APP_DEBUG_MEAN_WIDTH		3   /**< Characters of a mean on the timing screen */
+#define APP_DEBUG_MEAN_LIMIT		999 /**< Largest mean shown on the timing screen */
+#define APP_DEBUG_MAX_WIDTH			4   /**< Characters of a maximum on the timing screen */
+#define APP_DEBUG_MAX_LIMIT			9999 /**< Largest maximum shown on the timing screen */
+#define APP_US_PER_MS				1000UL /**< Microseconds per millisecond */
+#define APP_FIRST_SAMPLE_MS			20  /**< Longest wait of the welcome screen for the first reading, several readings long */
+#define APP_FIRST_SAMPLE_POLL_MS	1   /**< Poll period of that wait */
+
 
 #define APP_PORT					0
 #define APP_PIN						1
@@ -52,6 +70,27 @@ typedef uint8_t u8_programStateType;
 #define APP_SET_TEMP			((u8_programStateType)0x01) /**< Set temperature state */
 #define APP_WORKING				((u8_programStateType)0x02) /**< Working state */
 
+typedef uint8_t u8_uiStringType;
+
+#define APP_STR_WELCOME			((u8_uiStringType)0x00) /**< "Welcome" */
+#define APP_STR_DEFAULT_TEMP	((u8_uiStringType)0x01) /**< "default Temp is" */
+#define APP_STR_DEFAULT_VALUE	((u8_uiStringType)0x02) /**< "20" */
+#define APP_STR_SET_TEMP		((u8_uiStringType)0x03) /**< "Set Initial Temp" */
+#define APP_STR_MIN_TEMP		((u8_uiStringType)0x04) /**< "18" */
+#define APP_STR_MAX_TEMP		((u8_uiStringType)0x05) /**< "35" */
+#define APP_STR_CURRENT_TEMP	((u8_uiStringType)0x06) /**< "Current Temp = " */
+#define APP_STR_BLANK			((u8_uiStringType)0x07) /**< " " */
+#define APP_STR_RESET_LINE_1	((u8_uiStringType)0x08) /**< "Temp value is" */
+#define APP_STR_RESET_LINE_2	((u8_uiStringType)0x09) /**< "resettled to 20" */
+#define APP_STR_NO_READING		((u8_uiStringType)0x0A) /**< "--.-" */
+#if KEYPAD_INSTRUMENTATION == TRUE
+#define APP_STR_DEBUG_SCAN		((u8_uiStringType)0x0B) /**< "Scan    /    us" */
+#define APP_STR_DEBUG_KEY		((u8_uiStringType)0x0C) /**< "Key     /    ms" */
+#define APP_STR_COUNT			13 /**< Number of UI strings */
+#else
+#define APP_STR_COUNT			11 /**< Number of UI strings */
+#endif
+
 /**
  * @brief Start the application.
  *
@@ -89,11 +128,4 @@ void APP_working(void);
  */
 void APP_timer0OvfHandeler(void);
 
-/**
- * @brief Print the current temperature on the LCD.
- *
- * @param copy_d_temp The current temperature to display.
- */
-void APP_printString(double copy_d_temp);
-
 #endif /* APP_H	*/
\ No newline at end of file
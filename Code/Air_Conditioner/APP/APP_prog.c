@@ -13,7 +13,6 @@
 
 void APP_timer1OvfHandeler(void);
 
-uint8_t gs_ptr_str_curTempToString[APP_TEMP_STRING_SIZE];
 /** Timer configuration for Timer 1 */
 static timerm_str_config_t gs_str_timer_1_config;
 
@@ -23,6 +22,9 @@ static timerm_str_config_t gs_str_timer_1_config;
 static lm35_str_config_t	gs_lm35_str_config;
 static lm35_str_channel_t	gs_str_lm35_str_channel_config;
 
+/** Filter chain of the readings, so one noisy sample near the setpoint does not toggle the buzzer */
+static filter_str_stage_t	gs_str_arr_tempFilter[APP_FILTER_STAGES];
+
 /** LCD configuration */
 lcd_str_config_t gs_str_lcd_config;
 
@@ -32,28 +34,74 @@ keypad_str_config_t gs_str_keypad_config;
 /** Buzzer configuration */
 static buzzer_str_config_t gs_str_buzzer_config;
 
+/** Setpoint knob configuration */
+static encoder_str_config_t gs_str_encoder_config;
+
+/** Flash-resident UI strings, each only as long as its text */
+static const uint8_t gs_u8_arr_strWelcome[] PROGMEM		= "Welcome";
+static const uint8_t gs_u8_arr_strDefaultTemp[] PROGMEM	= "default Temp is";
+static const uint8_t gs_u8_arr_strDefaultValue[] PROGMEM	= "20";
+static const uint8_t gs_u8_arr_strSetTemp[] PROGMEM		= "Set Initial Temp";
+static const uint8_t gs_u8_arr_strMinTemp[] PROGMEM		= "18";
+static const uint8_t gs_u8_arr_strMaxTemp[] PROGMEM		= "35";
+static const uint8_t gs_u8_arr_strCurrentTemp[] PROGMEM	= "Current Temp = ";
+static const uint8_t gs_u8_arr_strBlank[] PROGMEM			= " ";
+static const uint8_t gs_u8_arr_strResetLine1[] PROGMEM		= "Temp value is";
+static const uint8_t gs_u8_arr_strResetLine2[] PROGMEM		= "resettled to 20";
+static const uint8_t gs_u8_arr_strNoReading[] PROGMEM		= "--.-";
+#if KEYPAD_INSTRUMENTATION == TRUE
+static const uint8_t gs_u8_arr_strDebugScan[] PROGMEM		= "Scan    /    us";
+static const uint8_t gs_u8_arr_strDebugKey[] PROGMEM		= "Key     /    ms";
+#endif
+
+/** Flash addresses of the UI strings, indexed by u8_uiStringType */
+static const uint8_t * const gs_ptr_u8_arr_uiStrings[APP_STR_COUNT] PROGMEM = {
+	gs_u8_arr_strWelcome,			// APP_STR_WELCOME
+	gs_u8_arr_strDefaultTemp,		// APP_STR_DEFAULT_TEMP
+	gs_u8_arr_strDefaultValue,		// APP_STR_DEFAULT_VALUE
+	gs_u8_arr_strSetTemp,			// APP_STR_SET_TEMP
+	gs_u8_arr_strMinTemp,			// APP_STR_MIN_TEMP
+	gs_u8_arr_strMaxTemp,			// APP_STR_MAX_TEMP
+	gs_u8_arr_strCurrentTemp,		// APP_STR_CURRENT_TEMP
+	gs_u8_arr_strBlank,				// APP_STR_BLANK
+	gs_u8_arr_strResetLine1,		// APP_STR_RESET_LINE_1
+	gs_u8_arr_strResetLine2,		// APP_STR_RESET_LINE_2
+	gs_u8_arr_strNoReading,			// APP_STR_NO_READING
+#if KEYPAD_INSTRUMENTATION == TRUE
+	gs_u8_arr_strDebugScan,			// APP_STR_DEBUG_SCAN
+	gs_u8_arr_strDebugKey			// APP_STR_DEBUG_KEY
+#endif
+};
+
+/** Invalid-key notice, longer than a row: it scrolls through the first row with the display shift */
+static const uint8_t gs_u8_arr_invalidNotice[] PROGMEM = "the operation is not allowed";
+
+/** Flash address of a UI string, read from the flash table */
+#define APP_UI_STRING(ID)		((const uint8_t *)pgm_read_word(&gs_ptr_u8_arr_uiStrings[(ID)]))
+
 /** Program state variable */
 static u8_programStateType u8_en_gs_programState = APP_WELCOME;
 
 /** Delay variable */
 static uint8_t gs_u8_delay = 0;
 
-/** Default temperature setting */
-const  uint8_t u8_gc_defaultTemp = 20;
+/** Default temperature setting, in half degrees */
+const  uint8_t u8_gc_defaultTemp = 20 * APP_TEMP_STEPS_PER_DEGREE;
+
+/** Current temperature, Q8.8 degrees */
+static sint16_t gs_s16_curTemp = 20 * (1 << APP_READING_FRAC_BITS);
 
-/** Current temperature variable */
-static double gs_d_curTemp = 20.0;
+/** Outcome of the sensor start-up, no reading can arrive when it failed */
+static lm35_enu_return_state_t gs_enu_sensorState = LM35_NOK;
 
-/** Program temperature variable */
+/** TRUE once the sensor has delivered a reading, gs_s16_curTemp holds no measurement before that */
+static uint8_t gs_u8_haveTemp = FALSE;
+
+/** Program temperature variable, in half degrees */
 static uint8_t u8_gs_programTemp = 0;
 
-/**
- * @brief Convert an integer to a string.
- *
- * @param copy_u8_num The integer to convert.
- * @param ptr_string Pointer to the string to store the result.
- */
-static void intToString(uint8_t copy_u8_num, uint8_t *ptr_string);
+/** Setpoint bar of the set screen */
+static lcd_str_bargraph_t gs_str_setBar;
 
 /**
  * @brief Delay for a specified number of half-seconds.
@@ -62,6 +110,64 @@ static void intToString(uint8_t copy_u8_num, uint8_t *ptr_string);
  */
 static void delay_half_sec(uint8_t u8_delay_half_sec);
 
+/**
+ * @brief Show the setpoint as degrees with one decimal and move the setpoint bar to it.
+ */
+static void APP_showSetpoint(void);
+
+/**
+ * @brief End a scrolling notice and wait until the display is back at its start position.
+ */
+static void APP_stopNotice(void);
+
+/**
+ * @brief Free-running milliseconds of the keypad scan, the clock of the knob acceleration.
+ *
+ * @return Time in milliseconds.
+ */
+static uint16_t APP_timeMs(void);
+
+/**
+ * @brief Move the setpoint by a signed number of steps, clamped to the setpoint range.
+ *
+ * @param s16_steps Steps to move, in half degrees.
+ */
+static void APP_moveSetpoint(sint16_t s16_steps);
+
+/**
+ * @brief Take the newest sensor reading, if any, without waiting for a conversion.
+ */
+static void APP_readTemp(void);
+
+/**
+ * @brief Show the current temperature in the second row, or a placeholder before the first reading.
+ */
+static void APP_showTemp(void);
+
+/**
+ * @brief Sleep until an interrupt if the current screen has nothing to do.
+ *
+ * Both screens wait for a key event; the set screen also waits for the knob and the working screen for a new
+ * sensor sample. The check runs with interrupts disabled so an event that arrives during it still wakes the CPU.
+ */
+static void APP_idle(void);
+
+#if KEYPAD_INSTRUMENTATION == TRUE
+/**
+ * @brief Show the keypad scan cost and the press-to-action latency, mean and maximum, until a key is pressed.
+ */
+static void APP_debug(void);
+
+/**
+ * @brief Limit a value to what fits its field on the timing screen.
+ *
+ * @param u32_value Value to show.
+ * @param s16_limit Largest value the field holds.
+ * @return The value, at most s16_limit.
+ */
+static sint16_t APP_debugValue(uint32_t u32_value, sint16_t s16_limit);
+#endif
+
 
 void APP_start(void)
 {
@@ -89,27 +195,7 @@ void APP_start(void)
 
 void APP_init(void)
 {
-	// Initialize timer 1 in Normal mode with OVF interrupt enabled and interrupt period every 0.5 ms
-	gs_str_timer_1_config.enu_timer_no = TIMER_1;
-	gs_str_timer_1_config.enu_timer_mode = TIMER_NORMAL_MODE;
-	gs_str_timer_1_config.u16_timer_initial_value = APP_TIMER_1_INIT_VALUE;
-	gs_str_timer_1_config.ptr_call_back_func =  APP_timer1OvfHandeler;
-	gs_str_timer_1_config.enu_prescaller = F_CPU_1024;	
-	
-	TIMER_MANGER_init(&gs_str_timer_1_config);
-	
-	
-	// Initialize The Temp. sensor 
-	gs_str_lm35_str_channel_config.str_lm35_channel.enu_channel_pin = PIN7;
-	gs_str_lm35_str_channel_config.str_lm35_channel.enu_channel_port = PORTA;
-	gs_lm35_str_config.str_lm35_adc_config.adc_enu_vref = ADC_EXTERNAL_VREF;
-	gs_lm35_str_config.str_lm35_adc_config.adc_enu_prescaler = ADC_PRESCALER_2;
-	LM35_init(&gs_str_lm35_str_channel_config, &gs_lm35_str_config);
-	
-	
-	
-	
-	// Initialize the LCD
+	// Initialize the LCD first: its power-up sequence runs on the queue tick while the rest is set up
 	gs_str_lcd_config.enu_mode = LCD_4_BIT_MODE;
 	
 	gs_str_lcd_config.str_data_pins[0].enu_port = PORTC;
@@ -133,9 +219,44 @@ void APP_init(void)
 	gs_str_lcd_config.str_Epin.enu_port = PORTC	;
 	gs_str_lcd_config.str_Epin.enu_pin	= PIN6;
 	
+	// RW is wired, so pace transfers with the busy flag instead of fixed delays
+	gs_str_lcd_config.enu_sync = LCD_SYNC_BUSY_FLAG;
+	
+	// queue LCD transfers so the control loop never waits for the controller
+	gs_str_lcd_config.enu_transfer = LCD_TRANSFER_ASYNC;
+	
+	// panel wired to the pins above; LCD_BUS_PCF8574 with u8_i2c_address selects an I2C backpack instead
+	gs_str_lcd_config.enu_bus = LCD_BUS_PARALLEL;
+	
 	LCD_init(&gs_str_lcd_config);
 	
 	
+	// Initialize timer 1 in Normal mode with OVF interrupt enabled and interrupt period every 0.5 ms
+	gs_str_timer_1_config.enu_timer_no = TIMER_1;
+	gs_str_timer_1_config.enu_timer_mode = TIMER_NORMAL_MODE;
+	gs_str_timer_1_config.u16_timer_initial_value = APP_TIMER_1_INIT_VALUE;
+	gs_str_timer_1_config.ptr_call_back_func =  APP_timer1OvfHandeler;
+	gs_str_timer_1_config.enu_prescaller = F_CPU_1024;	
+	
+	TIMER_MANGER_init(&gs_str_timer_1_config);
+	
+	
+	// Initialize The Temp. sensor 
+	gs_str_lm35_str_channel_config.str_lm35_channel.enu_channel_pin = PIN7;
+	gs_str_lm35_str_channel_config.str_lm35_channel.enu_channel_port = PORTA;
+	gs_lm35_str_config.str_lm35_adc_config.adc_enu_vref = ADC_EXTERNAL_VREF;
+	// 62.5 kHz conversion clock: full 10-bit accuracy, one sample every 208 us in the background
+	gs_lm35_str_config.str_lm35_adc_config.adc_enu_prescaler = ADC_PRESCALER_128;
+	gs_lm35_str_config.enu_lm35_trigger = ADC_TRIGGER_FREE_RUNNING;
+	// 16 conversions per reading give 12 bits, about 0.12 degree per step, at 300 readings per second
+	gs_lm35_str_config.str_lm35_adc_config.u8_oversample_bits = 2;
+	FILTER_init(&gs_str_arr_tempFilter[0], FILTER_MEDIAN, APP_FILTER_MEDIAN);
+	FILTER_init(&gs_str_arr_tempFilter[1], FILTER_AVERAGE, APP_FILTER_AVG_BITS);
+	FILTER_init(&gs_str_arr_tempFilter[2], FILTER_IIR, APP_FILTER_IIR_SHIFT);
+	gs_lm35_str_config.ptr_str_filter = gs_str_arr_tempFilter;
+	gs_lm35_str_config.u8_filter_stages = APP_FILTER_STAGES;
+	gs_enu_sensorState = LM35_init(&gs_str_lm35_str_channel_config, &gs_lm35_str_config);
+	
 	
 	
 	
@@ -162,6 +283,9 @@ void APP_init(void)
 	gs_str_keypad_config.str_row_pins[3].enu_port = PORTA;
 	gs_str_keypad_config.str_row_pins[3].enu_pin  = PIN3 ;
 	
+	// the rows are not wired to an external interrupt on this board
+	gs_str_keypad_config.enu_scan = KEYPAD_SCAN_CONTINUOUS;
+	
 	KEYPAD_init(&gs_str_keypad_config);
 	
 	
@@ -169,24 +293,41 @@ void APP_init(void)
 	gs_str_buzzer_config.enu_port = PORTB;
 	gs_str_buzzer_config.enu_pin = PIN0;
 	BUZZER_init(&gs_str_buzzer_config);
+	
+	
+	// Initialize the setpoint knob, A on INT0 (PD2) and B on INT1 (PD3); turning faster moves further per detent
+	gs_str_encoder_config.enu_a_int = EXT_INT_0;
+	gs_str_encoder_config.enu_b_int = EXT_INT_1;
+	gs_str_encoder_config.ptr_fun_time_ms = APP_timeMs;
+	ENCODER_init(&gs_str_encoder_config);
 }
 
 void APP_welcome(void)
 {
+	uint16_t u16_waited_ms = 0;
+	
 	LCD_clear(&gs_str_lcd_config);
-	LCD_setCursor(&gs_str_lcd_config,LCD_ROW_1,LCD_COL_1);
+	LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1, APP_UI_STRING(APP_STR_WELCOME));
 	
-	LCD_writeString(&gs_str_lcd_config,(uint8_t*)"Welcome");
+	// the first reading is a few conversions away; a sensor that does not deliver in time shows the placeholder
+	// and the working screen fills in the value once it arrives
+	APP_readTemp();
+	while ((gs_enu_sensorState == LM35_OK) && (gs_u8_haveTemp == FALSE) && (u16_waited_ms < APP_FIRST_SAMPLE_MS))
+	{
+		DELAY_ms(APP_FIRST_SAMPLE_POLL_MS);
+		u16_waited_ms += APP_FIRST_SAMPLE_POLL_MS;
+		APP_readTemp();
+	}
+	// queued behind the LCD power-up sequence, shown as soon as the controller is ready
+	APP_showTemp();
+	LCD_refresh(&gs_str_lcd_config);
 	delay_half_sec(APP_DELAY_1_S);
 	
 	LCD_clear(&gs_str_lcd_config);
-	LCD_setCursor(&gs_str_lcd_config,LCD_ROW_1,LCD_COL_1);
-	
-	LCD_writeString(&gs_str_lcd_config, (uint8_t*)"default Temp is");
+	LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1, APP_UI_STRING(APP_STR_DEFAULT_TEMP));
 	
-	LCD_setCursor(&gs_str_lcd_config,LCD_ROW_2,LCD_COL_1);
-
-	LCD_writeString(&gs_str_lcd_config, (uint8_t*)"20");
+	LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1, APP_UI_STRING(APP_STR_DEFAULT_VALUE));
+	LCD_refresh(&gs_str_lcd_config);
 	delay_half_sec(APP_DELAY_1_S);
 
 	
@@ -196,62 +337,67 @@ void APP_welcome(void)
 
 void APP_set(void)
 {
-	uint8_t u8_loadingChar[] = "|";
-	uint8_t u8_emptyChar[] = " ";
-	uint8_t u8_keypadData = 0;
+	keypad_str_event_t str_keyEvent;
+	sint8_t s8_steps = 0;
 	
 
 	LCD_clear(&gs_str_lcd_config);
 	
-	LCD_setCursor(&gs_str_lcd_config,LCD_ROW_1,LCD_COL_1);
-
-
-	LCD_writeString(&gs_str_lcd_config, (uint8_t*)"Set Initial Temp");
+	LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1, APP_UI_STRING(APP_STR_SET_TEMP));
+	LCD_refresh(&gs_str_lcd_config);
 	delay_half_sec(APP_DELAY_0_5_S);
 
 	LCD_clear(&gs_str_lcd_config);
-	LCD_setCursor(&gs_str_lcd_config,LCD_ROW_1,LCD_COL_1);
-
-	LCD_writeString(&gs_str_lcd_config, (uint8_t*)"Min=18");
-	LCD_setCursor(&gs_str_lcd_config,LCD_ROW_1,LCD_COL_11);
-	LCD_writeString(&gs_str_lcd_config, (uint8_t*)"Max=35");
+	// the limits sit above the ends of the bar
+	LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1, APP_UI_STRING(APP_STR_MIN_TEMP));
+	LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_15, APP_UI_STRING(APP_STR_MAX_TEMP));
 	
-	for (uint8_t u8_index = 19 ; u8_index <= u8_gs_programTemp ;u8_index++)
-	{
-		
-		LCD_setCursor(&gs_str_lcd_config,LCD_ROW_2,u8_index-19);
-		LCD_writeString(&gs_str_lcd_config, (uint8_t*)u8_loadingChar);
-	}
+	LCD_bargraphInit(&gs_str_lcd_config, &gs_str_setBar, LCD_ROW_2, LCD_COL_1, LCD_COLS_MAX);
+	
+	// turns made on the working screen do not move the setpoint, and the step count only holds 127 detents
+	ENCODER_read(&gs_str_encoder_config, &s8_steps);
 	while(1)
 	{
-		intToString(u8_gs_programTemp, gs_ptr_str_curTempToString);
-		LCD_setCursor(&gs_str_lcd_config,LCD_ROW_1,LCD_COL_8);
-		LCD_writeString(&gs_str_lcd_config, gs_ptr_str_curTempToString);
+		// only the bar cells around the old and new levels change, sent together in one frame
+		LCD_beginFrame(&gs_str_lcd_config);
+		APP_showSetpoint();
+		LCD_endFrame(&gs_str_lcd_config);
 		
-		KEYPAD_read(&gs_str_keypad_config, &u8_keypadData);
+		// the knob and the keys both move the setpoint
+		ENCODER_read(&gs_str_encoder_config, &s8_steps);
+		APP_moveSetpoint(s8_steps);
 		
-		if (u8_keypadData == APP_INCREMENT_BTN)
+		if (KEYPAD_readEvent(&gs_str_keypad_config, &str_keyEvent) != KEYPAD_E_OK)
 		{
-
-			if (u8_gs_programTemp < 35)
-			{
-				u8_gs_programTemp++;
-				
-				LCD_setCursor(&gs_str_lcd_config,LCD_ROW_2, u8_gs_programTemp-19);
-				LCD_writeString(&gs_str_lcd_config, (uint8_t*)u8_loadingChar);
-			}
+			// no key event
 		}
-		else if (u8_keypadData == APP_DECREMENT_BTN)
+		else if ((str_keyEvent.enu_event != KEYPAD_EVENT_PRESS) && (str_keyEvent.enu_event != KEYPAD_EVENT_REPEAT))
 		{
-			// Decrement
-			if (u8_gs_programTemp >18)
+			// releases and the long-press itself do not move the setpoint
+		}
+		else if ((str_keyEvent.u8_key == APP_INCREMENT_BTN) || (str_keyEvent.u8_key == APP_DECREMENT_BTN))
+		{
+			// a held key repeats faster and faster, after a while it also moves a whole degree per repeat
+			if ((str_keyEvent.enu_event == KEYPAD_EVENT_REPEAT) && (str_keyEvent.u8_repeat >= APP_REPEAT_FAST_COUNT))
+			{
+				s8_steps = APP_TEMP_STEPS_PER_DEGREE;
+			}
+			else
+			{
+				s8_steps = 1;
+			}
+			
+			if (str_keyEvent.u8_key == APP_INCREMENT_BTN)
+			{
+				APP_moveSetpoint(s8_steps);
+			}
+			else
 			{
-				u8_gs_programTemp--;
-				LCD_setCursor(&gs_str_lcd_config,LCD_ROW_2, u8_gs_programTemp-18);
-				LCD_writeString(&gs_str_lcd_config, (uint8_t*)u8_emptyChar);
+				// Decrement
+				APP_moveSetpoint(-s8_steps);
 			}
 		}
-		else if (u8_keypadData == APP_SET_BTN)
+		else if (str_keyEvent.u8_key == APP_SET_BTN)
 		{
 			// Set
 			u8_en_gs_programState = APP_WORKING;
@@ -260,6 +406,8 @@ void APP_set(void)
 		else{
 			// do nothing
 		}
+		
+		APP_idle();
 	}
 	
 }
@@ -270,20 +418,19 @@ void APP_working(void)
 	
 	// print current temp
 	LCD_clear(&gs_str_lcd_config);
-	LCD_setCursor(&gs_str_lcd_config,LCD_ROW_1,LCD_COL_1);
-	LCD_writeString(&gs_str_lcd_config, (uint8_t*)"Current Temp = ");
+	LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1, APP_UI_STRING(APP_STR_CURRENT_TEMP));
 	
 	
 	while(u8_en_gs_programState == APP_WORKING)
 	{
+		// the reading and the alarm cell are sent together when the frame closes
+		LCD_beginFrame(&gs_str_lcd_config);
+		
 		// read the temp from the sensor
-		LM35_read_temp(&gs_str_lm35_str_channel_config, &gs_lm35_str_config, &gs_d_curTemp);		
-		LCD_setCursor(&gs_str_lcd_config,LCD_ROW_2,LCD_COL_2);
-		intToString((uint8_t)gs_d_curTemp,gs_ptr_str_curTempToString);
-		LCD_writeString(&gs_str_lcd_config, gs_ptr_str_curTempToString);
-		//APP_printString(gs_d_curTemp);
-		//LCD_writeString((uint8_t*)ch_arrs_curTempToString);
-		if (gs_d_curTemp > u8_gs_programTemp)
+		APP_readTemp();
+		APP_showTemp();
+		// both sides in Q8.8, no floating point; no alarm before the first reading
+		if ((gs_u8_haveTemp == TRUE) && (gs_s16_curTemp > APP_SETPOINT_TO_READING(u8_gs_programTemp)))
 		{
 			
 			LCD_writeSpChar(&gs_str_lcd_config, LCD_BELL);
@@ -293,11 +440,13 @@ void APP_working(void)
 			BUZZER_start();
 		}
 		else{
-			LCD_setCursor(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1);
-			LCD_writeString(&gs_str_lcd_config, (uint8_t*)" ");
+			LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1, APP_UI_STRING(APP_STR_BLANK));
 			BUZZER_stop();
 		}
 		
+		// send only the cells that changed since the last pass
+		LCD_endFrame(&gs_str_lcd_config);
+		
 		KEYPAD_read(&gs_str_keypad_config, &u8_keypadData);
 		switch(u8_keypadData)
 		{
@@ -307,18 +456,16 @@ void APP_working(void)
 				// reset
 				// Stop the BUZZER
 				BUZZER_stop();
+				APP_stopNotice();
 				
 				// Set the program temp with the default temp
 				u8_gs_programTemp = u8_gc_defaultTemp;
 				
 				// clear LCD and print Temp value is resettled to 20
 				LCD_clear(&gs_str_lcd_config);
-				LCD_setCursor(&gs_str_lcd_config,LCD_ROW_1,LCD_COL_1);
-				
-				LCD_writeString(&gs_str_lcd_config, (uint8_t*)"Temp value is");
-				LCD_setCursor(&gs_str_lcd_config,LCD_ROW_2,LCD_COL_1);
-				
-				LCD_writeString(&gs_str_lcd_config, (uint8_t*)"resettled to 20");
+				LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1, APP_UI_STRING(APP_STR_RESET_LINE_1));
+				LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1, APP_UI_STRING(APP_STR_RESET_LINE_2));
+				LCD_refresh(&gs_str_lcd_config);
 				delay_half_sec(APP_DELAY_1_S);
 				
 				// change the program state
@@ -330,27 +477,36 @@ void APP_working(void)
 				
 				// Stop the BUZZER
 				BUZZER_stop();
+				APP_stopNotice();
 				
 				// change the program state
 				u8_en_gs_programState = APP_SET_TEMP;
 				break;
-			default:
+#if KEYPAD_INSTRUMENTATION == TRUE
+			case APP_DEBUG_BTN :
+				// keypad timing, any key goes back to the reading
+				BUZZER_stop();
+				APP_stopNotice();
+				APP_debug();
 				
-				// Invalid button
 				LCD_clear(&gs_str_lcd_config);
-				LCD_setCursor(&gs_str_lcd_config,LCD_ROW_1,LCD_COL_1);
-				LCD_writeString(&gs_str_lcd_config, (uint8_t*)"the operation is");
-				LCD_setCursor(&gs_str_lcd_config,LCD_ROW_2,LCD_COL_1);
+				LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1, APP_UI_STRING(APP_STR_CURRENT_TEMP));
+				break;
+#endif
+			default:
 				
-				LCD_writeString(&gs_str_lcd_config, (uint8_t*)"not allowed");
-				delay_half_sec(APP_DELAY_1_S);
+				// Invalid button: scroll the notice once through the first row, the loop keeps running meanwhile
+				LCD_clear(&gs_str_lcd_config);
+				LCD_refresh(&gs_str_lcd_config);
+				LCD_marqueeStart(&gs_str_lcd_config, LCD_ROW_1, gs_u8_arr_invalidNotice, APP_NOTICE_STEP_MS, LCD_MARQUEE_PASS_STEPS);
 				
-				// print current temp
+				// print current temp, shown as soon as the notice ends
 				LCD_clear(&gs_str_lcd_config);
-				LCD_setCursor(&gs_str_lcd_config,LCD_ROW_1,LCD_COL_1);
-				LCD_writeString(&gs_str_lcd_config, (uint8_t*)"Current Temp = ");
+				LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1, APP_UI_STRING(APP_STR_CURRENT_TEMP));
 				break;
 		}
+		
+		APP_idle();
 	}
 	
 }
@@ -363,39 +519,177 @@ void APP_timer1OvfHandeler(void)
 }
 
 
-void intToString(uint8_t copy_u8_num, uint8_t *ptr_string) {
-	uint8_t u8_digit_counter = U8_ZERO_VALUE;
+static void APP_showSetpoint(void)
+{
+	uint8_t u8_level = (uint8_t)(((uint16_t)(u8_gs_programTemp - APP_TEMP_MIN) * APP_SET_BAR_STEPS) / (APP_TEMP_MAX - APP_TEMP_MIN));
+	
+	LCD_setCursor(&gs_str_lcd_config,LCD_ROW_1,LCD_COL_7);
+	LCD_writeFixed(&gs_str_lcd_config, u8_gs_programTemp, APP_TEMP_FRAC_BITS, APP_TEMP_DECIMALS, APP_TEMP_FIELD_WIDTH);
+	
+	LCD_bargraphSet(&gs_str_lcd_config, &gs_str_setBar, u8_level);
+}
 
-	if (copy_u8_num == U8_ZERO_VALUE) {
-		u8_digit_counter = U8_ONE_VALUE;
-		} else {
-		uint8_t temp = copy_u8_num;  // Store a temporary copy of the number
-		while (temp != U8_ZERO_VALUE) {
-			temp /= APP_SELECT_TENS_DIGIT;
-			u8_digit_counter++;
-		}
+static void APP_stopNotice(void)
+{
+	uint8_t u8_active = TRUE;
+	
+	LCD_marqueeStop(&gs_str_lcd_config);
+	while(u8_active == TRUE)
+	{
+		LCD_marqueeIsActive(&gs_str_lcd_config, &u8_active);
 	}
-	u8_digit_counter++;
+}
+
+static uint16_t APP_timeMs(void)
+{
+	uint16_t u16_time_ms = 0;
+	
+	KEYPAD_readTime(&gs_str_keypad_config, &u16_time_ms);
+	return u16_time_ms;
+}
 
+static void APP_moveSetpoint(sint16_t s16_steps)
+{
+	sint16_t s16_temp = (sint16_t)u8_gs_programTemp + s16_steps;
+	
+	if (s16_temp > APP_TEMP_MAX)
+	{
+		s16_temp = APP_TEMP_MAX;
+	}
+	else if (s16_temp < APP_TEMP_MIN)
+	{
+		s16_temp = APP_TEMP_MIN;
+	}
+	else
+	{
+		// inside the range
+	}
+	u8_gs_programTemp = (uint8_t)s16_temp;
+}
+
+static void APP_readTemp(void)
+{
+	if (LM35_read_temp(&gs_str_lm35_str_channel_config, &gs_lm35_str_config, &gs_s16_curTemp) == LM35_OK)
+	{
+		gs_u8_haveTemp = TRUE;
+	}
+	else
+	{
+		// no sample yet, the last reading stays
+	}
+}
 
-	uint8_t u8_string_counter = u8_digit_counter - U8_ONE_VALUE;  // Start from the end of the buffer
-	ptr_string[u8_string_counter] = APP_NULL_TERMINATION_STRING;  // Null-terminate the string
+static void APP_showTemp(void)
+{
+	if (gs_u8_haveTemp == TRUE)
+	{
+		LCD_setCursor(&gs_str_lcd_config,LCD_ROW_2,LCD_COL_2);
+		LCD_writeFixed(&gs_str_lcd_config, gs_s16_curTemp, APP_READING_FRAC_BITS, APP_TEMP_DECIMALS, APP_TEMP_FIELD_WIDTH);
+	}
+	else
+	{
+		LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_2, APP_UI_STRING(APP_STR_NO_READING));
+	}
+}
 
-	if (copy_u8_num == U8_ZERO_VALUE) {
-		ptr_string[--u8_string_counter] = APP_0_CHAR;  // Handle the special case of zero
-		} else {
-		while (copy_u8_num > U8_ZERO_VALUE && u8_string_counter > U8_ZERO_VALUE) {
-			ptr_string[--u8_string_counter] = '0' + (copy_u8_num % APP_SELECT_TENS_DIGIT); // Convert the digit to character
-			copy_u8_num /= APP_SELECT_TENS_DIGIT;
+static void APP_idle(void)
+{
+	uint8_t u8_idle = FALSE;
+	uint8_t u8_samples = 0;
+	
+	cli();
+	KEYPAD_isIdle(&gs_str_keypad_config, &u8_idle);
+	if (u8_idle == FALSE)
+	{
+		// a key event is waiting
+	}
+	else if (u8_en_gs_programState == APP_SET_TEMP)
+	{
+		ENCODER_isIdle(&gs_str_encoder_config, &u8_idle);
+	}
+	else
+	{
+		ADC_acquisition_available(&u8_samples);
+		if (u8_samples != 0)
+		{
+			u8_idle = FALSE;
+		}
+		else
+		{
+			// no new reading
 		}
 	}
+	
+	if (u8_idle == TRUE)
+	{
+		// interrupts come back on together with the sleep
+		SLEEP_idle();
+	}
+	else
+	{
+		sei();
+	}
 }
 
+#if KEYPAD_INSTRUMENTATION == TRUE
+static void APP_debug(void)
+{
+	keypad_str_stats_t str_stats;
+	uint8_t u8_keypadData = APP_NO_BTN;
+	
+	LCD_clear(&gs_str_lcd_config);
+	LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1, APP_UI_STRING(APP_STR_DEBUG_SCAN));
+	LCD_writeStringAt_P(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1, APP_UI_STRING(APP_STR_DEBUG_KEY));
+	LCD_refresh(&gs_str_lcd_config);
+	
+	while (u8_keypadData == APP_NO_BTN)
+	{
+		KEYPAD_readStats(&gs_str_keypad_config, &str_stats);
+		
+		// only the digits that changed are sent
+		LCD_beginFrame(&gs_str_lcd_config);
+		LCD_setCursor(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_6);
+		LCD_writeNumber(&gs_str_lcd_config, APP_debugValue(str_stats.str_scan.u32_mean_us, APP_DEBUG_MEAN_LIMIT), APP_DEBUG_MEAN_WIDTH);
+		LCD_setCursor(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_10);
+		LCD_writeNumber(&gs_str_lcd_config, APP_debugValue(str_stats.str_scan.u32_max_us, APP_DEBUG_MAX_LIMIT), APP_DEBUG_MAX_WIDTH);
+		LCD_setCursor(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_6);
+		LCD_writeNumber(&gs_str_lcd_config, APP_debugValue(str_stats.str_latency.u32_mean_us / APP_US_PER_MS, APP_DEBUG_MEAN_LIMIT), APP_DEBUG_MEAN_WIDTH);
+		LCD_setCursor(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_10);
+		LCD_writeNumber(&gs_str_lcd_config, APP_debugValue(str_stats.str_latency.u32_max_us / APP_US_PER_MS, APP_DEBUG_MAX_LIMIT), APP_DEBUG_MAX_WIDTH);
+		LCD_endFrame(&gs_str_lcd_config);
+		
+		KEYPAD_read(&gs_str_keypad_config, &u8_keypadData);
+	}
+}
+
+static sint16_t APP_debugValue(uint32_t u32_value, sint16_t s16_limit)
+{
+	sint16_t s16_value = s16_limit;
+	
+	if (u32_value < (uint32_t)s16_limit)
+	{
+		s16_value = (sint16_t)u32_value;
+	}
+	else
+	{
+		// field full
+	}
+	return s16_value;
+}
+#endif
+
 void delay_half_sec(uint8_t u8_delay_half_sec){
 	
 	gs_u8_delay = 0;
 	TIMER_MANGER_start(gs_str_timer_1_config.enu_prescaller,gs_str_timer_1_config.enu_timer_no);
-	while(gs_u8_delay <= u8_delay_half_sec);
+	// the half-second overflow wakes the CPU, checked with interrupts off so it cannot slip in before the sleep
+	cli();
+	while(gs_u8_delay <= u8_delay_half_sec)
+	{
+		SLEEP_idle();
+		cli();
+	}
+	sei();
 	TIMER_MANGER_stop(gs_str_timer_1_config.enu_timer_no);
 	
 	
@@ -0,0 +1,91 @@
+/**
+ * @file ENCODER_interface.h
+ * @brief Rotary encoder module interface.
+ *
+ * This file defines the interface for the quadrature rotary encoder module. Channels A and B each sit on an
+ * external interrupt; every edge is decoded in the interrupt and whole detents are added to a position
+ * counter that the application reads as a signed number of steps.
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+
+#ifndef ENCODER_INTERFACE_H_
+#define ENCODER_INTERFACE_H_
+
+#include "../../MCAL/EXT_INT/EXT_INT_interface.h"
+#include "../../MCAL/AVR_ARCH/PGM_interface.h"
+
+/** Quadrature states (edges) per detent of the knob. */
+#define ENCODER_STEPS_PER_DETENT        4
+
+/** Detents closer together than this count as fast turning. */
+#define ENCODER_ACCEL_FAST_MS           30U
+
+/** Detents closer together than this count as medium turning. */
+#define ENCODER_ACCEL_MEDIUM_MS         80U
+
+/** Steps added per detent when turning fast. */
+#define ENCODER_ACCEL_FAST_STEPS        4
+
+/** Steps added per detent when turning at medium speed. */
+#define ENCODER_ACCEL_MEDIUM_STEPS      2
+
+/** Function returning a free-running time in milliseconds, used to measure the turning speed. */
+typedef uint16_t (*encoder_ptr_time_ms_t)(void);
+
+/** Configuration structure for the encoder module. */
+typedef struct
+{
+	ext_int_enu_source_t enu_a_int;         /**< Interrupt whose pin carries channel A (INT0 or INT1). */
+	ext_int_enu_source_t enu_b_int;         /**< Interrupt whose pin carries channel B (INT0 or INT1). */
+	encoder_ptr_time_ms_t ptr_fun_time_ms;  /**< Time source of the acceleration, NULL for one step per detent. */
+}encoder_str_config_t;
+
+/** Enumeration of possible return states for encoder module functions. */
+typedef enum{
+		ENCODER_E_OK,       /**< Operation completed successfully. */
+		ENCODER_E_NOT_OK,   /**< Operation not successful. */
+		ENCODER_NULL_PTR    /**< Null pointer provided as argument. */
+}encoder_enu_return_state_t;
+
+/**
+ * @brief Initialize the encoder.
+ *
+ * This function sets both channel interrupts to fire on any change and enables them. Only one encoder is
+ * supported and the configuration must stay valid while it runs.
+ *
+ * @param[in] ptr_str_encoder_config Pointer to the encoder configuration structure.
+ * @return Operation status: ENCODER_E_OK if successful, ENCODER_NULL_PTR if NULL pointer provided,
+ *         ENCODER_E_NOT_OK if the interrupts are invalid, the same, or cannot sense both edges.
+ */
+encoder_enu_return_state_t ENCODER_init(encoder_str_config_t *ptr_str_encoder_config);
+
+/**
+ * @brief Read the steps turned since the last read.
+ *
+ * Clockwise is positive. With a time source each detent counts 1, ENCODER_ACCEL_MEDIUM_STEPS or
+ * ENCODER_ACCEL_FAST_STEPS steps depending on the time since the previous detent in the same direction.
+ * The reader must call this often enough to collect less than 128 steps between two calls.
+ *
+ * @param[in] ptr_str_encoder_config Pointer to the encoder configuration structure.
+ * @param[out] ptr_s8_steps Pointer to store the steps.
+ * @return Operation status: ENCODER_E_OK if successful, ENCODER_NULL_PTR if NULL pointer provided.
+ */
+encoder_enu_return_state_t ENCODER_read(encoder_str_config_t *ptr_str_encoder_config, sint8_t *ptr_s8_steps);
+
+/**
+ * @brief Check whether steps are waiting to be read.
+ *
+ * Every edge raises an interrupt that wakes the CPU, so when this reports TRUE the CPU can sleep until the
+ * knob is turned.
+ *
+ * @param[in] ptr_str_encoder_config Pointer to the encoder configuration structure.
+ * @param[out] ptr_u8_idle TRUE when the position has not changed since the last read, FALSE otherwise.
+ * @return Operation status: ENCODER_E_OK if successful, ENCODER_NULL_PTR if NULL pointer provided.
+ */
+encoder_enu_return_state_t ENCODER_isIdle(encoder_str_config_t *ptr_str_encoder_config, uint8_t *ptr_u8_idle);
+
+
+#endif /* ENCODER_INTERFACE_H_ */
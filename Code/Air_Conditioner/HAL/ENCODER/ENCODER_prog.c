@@ -0,0 +1,229 @@
+/**
+ * @file ENCODER_prog.c
+ * @brief Rotary encoder module implementation.
+ *
+ * This file contains the implementation of the quadrature decoder. The previous and the new level of the
+ * two channels index a transition table, so bounce that goes back and forth cancels out and invalid jumps
+ * count as nothing. The position is a free-running byte written only by the interrupt; the reader keeps
+ * its own copy and takes the difference, so no interrupt has to be disabled.
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+#include "ENCODER_interface.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
+
+
+/**
+ * @brief Quarter steps of each transition, indexed by (previous AB << 2) | new AB.
+ *
+ * Clockwise runs through 00, 01, 11, 10. Unchanged states and jumps over a state count as 0.
+ */
+static const sint8_t gs_s8_arr_transitions[16] PROGMEM = {
+	 0,  1, -1,  0,
+	-1,  0,  0,  1,
+	 1,  0,  0, -1,
+	 0, -1,  1,  0
+};
+
+/* Configuration of the running encoder, NULL before ENCODER_init */
+static encoder_str_config_t * volatile gs_ptr_str_encoderConfig = NULL;
+
+/* Levels of A and B at the last edge, A in bit 1 */
+static uint8_t gs_u8_lastState = U8_ZERO_VALUE;
+
+/* Quarter steps since the last detent */
+static sint8_t gs_s8_quarterSteps = U8_ZERO_VALUE;
+
+/* Time and direction of the last detent */
+static uint16_t gs_u16_lastDetentMs = U8_ZERO_VALUE;
+static sint8_t gs_s8_lastDirection = U8_ZERO_VALUE;
+
+/* Steps counted by the interrupt, free-running */
+static volatile uint8_t gs_u8_position = U8_ZERO_VALUE;
+
+/* Position at the last read, owned by the reader */
+static uint8_t gs_u8_readPosition = U8_ZERO_VALUE;
+
+/**
+ * @brief Sample both channels.
+ *
+ * @param[in] ptr_str_encoder_config Pointer to the encoder configuration structure.
+ * @return Levels of A and B, A in bit 1.
+ */
+static uint8_t ENCODER_readState(encoder_str_config_t *ptr_str_encoder_config);
+
+/**
+ * @brief Add one detent to the position, scaled by the turning speed.
+ *
+ * @param[in] ptr_str_encoder_config Pointer to the encoder configuration structure.
+ * @param[in] copy_s8_direction 1 for clockwise, -1 for counterclockwise.
+ */
+static void ENCODER_detent(encoder_str_config_t *ptr_str_encoder_config, sint8_t copy_s8_direction);
+
+/**
+ * @brief Channel interrupt callback, decodes one edge.
+ */
+static void ENCODER_edge(void);
+
+
+encoder_enu_return_state_t ENCODER_init(encoder_str_config_t *ptr_str_encoder_config)
+{
+	encoder_enu_return_state_t enu_return_state = ENCODER_E_OK;
+	
+	if(ptr_str_encoder_config == NULL)
+	{
+		enu_return_state = ENCODER_NULL_PTR;
+	}
+	else if(ptr_str_encoder_config->enu_a_int == ptr_str_encoder_config->enu_b_int)
+	{
+		enu_return_state = ENCODER_E_NOT_OK;
+	}
+	else if((EXT_INT_init(ptr_str_encoder_config->enu_a_int, EXT_INT_ANY_CHANGE, ENCODER_edge) != EXT_INT_E_OK)
+	|| (EXT_INT_init(ptr_str_encoder_config->enu_b_int, EXT_INT_ANY_CHANGE, ENCODER_edge) != EXT_INT_E_OK))
+	{
+		/* INT2 senses a single edge only */
+		enu_return_state = ENCODER_E_NOT_OK;
+	}
+	else
+	{
+		gs_u8_lastState = ENCODER_readState(ptr_str_encoder_config);
+		gs_s8_quarterSteps = U8_ZERO_VALUE;
+		gs_s8_lastDirection = U8_ZERO_VALUE;
+		gs_u8_position = U8_ZERO_VALUE;
+		gs_u8_readPosition = U8_ZERO_VALUE;
+		gs_ptr_str_encoderConfig = ptr_str_encoder_config;
+		EXT_INT_enable(ptr_str_encoder_config->enu_a_int);
+		EXT_INT_enable(ptr_str_encoder_config->enu_b_int);
+		sei();
+	}
+	return enu_return_state;
+}
+
+
+encoder_enu_return_state_t ENCODER_read(encoder_str_config_t *ptr_str_encoder_config, sint8_t *ptr_s8_steps)
+{
+	encoder_enu_return_state_t enu_return_state = ENCODER_E_OK;
+	uint8_t u8_position;
+	
+	if((ptr_str_encoder_config == NULL) || (ptr_s8_steps == NULL))
+	{
+		enu_return_state = ENCODER_NULL_PTR;
+	}
+	else
+	{
+		/* a single byte read, the difference is right across the wrap */
+		u8_position = gs_u8_position;
+		*ptr_s8_steps = (sint8_t)(uint8_t)(u8_position - gs_u8_readPosition);
+		gs_u8_readPosition = u8_position;
+	}
+	return enu_return_state;
+}
+
+encoder_enu_return_state_t ENCODER_isIdle(encoder_str_config_t *ptr_str_encoder_config, uint8_t *ptr_u8_idle)
+{
+	encoder_enu_return_state_t enu_return_state = ENCODER_E_OK;
+	
+	if((ptr_str_encoder_config == NULL) || (ptr_u8_idle == NULL))
+	{
+		enu_return_state = ENCODER_NULL_PTR;
+	}
+	else if(gs_u8_position == gs_u8_readPosition)
+	{
+		*ptr_u8_idle = TRUE;
+	}
+	else
+	{
+		*ptr_u8_idle = FALSE;
+	}
+	return enu_return_state;
+}
+
+
+static uint8_t ENCODER_readState(encoder_str_config_t *ptr_str_encoder_config)
+{
+	dio_enu_level_t enu_a_level = DIO_PIN_LOW_LEVEL;
+	dio_enu_level_t enu_b_level = DIO_PIN_LOW_LEVEL;
+	
+	EXT_INT_readPin(ptr_str_encoder_config->enu_a_int, &enu_a_level);
+	EXT_INT_readPin(ptr_str_encoder_config->enu_b_int, &enu_b_level);
+	return (uint8_t)((enu_a_level << U8_ONE_VALUE) | enu_b_level);
+}
+
+static void ENCODER_detent(encoder_str_config_t *ptr_str_encoder_config, sint8_t copy_s8_direction)
+{
+	uint8_t u8_steps = U8_ONE_VALUE;
+	uint16_t u16_now_ms;
+	uint16_t u16_elapsed_ms;
+	
+	if(ptr_str_encoder_config->ptr_fun_time_ms != NULL)
+	{
+		u16_now_ms = ptr_str_encoder_config->ptr_fun_time_ms();
+		u16_elapsed_ms = u16_now_ms - gs_u16_lastDetentMs;
+		gs_u16_lastDetentMs = u16_now_ms;
+		/* a reversal always starts slow */
+		if(copy_s8_direction != gs_s8_lastDirection)
+		{
+			//one step
+		}
+		else if(u16_elapsed_ms < ENCODER_ACCEL_FAST_MS)
+		{
+			u8_steps = ENCODER_ACCEL_FAST_STEPS;
+		}
+		else if(u16_elapsed_ms < ENCODER_ACCEL_MEDIUM_MS)
+		{
+			u8_steps = ENCODER_ACCEL_MEDIUM_STEPS;
+		}
+		else
+		{
+			//one step
+		}
+	}
+	else
+	{
+		//no time source, one step per detent
+	}
+	gs_s8_lastDirection = copy_s8_direction;
+	
+	if(copy_s8_direction > 0)
+	{
+		gs_u8_position += u8_steps;
+	}
+	else
+	{
+		gs_u8_position -= u8_steps;
+	}
+}
+
+static void ENCODER_edge(void)
+{
+	encoder_str_config_t *ptr_str_config = gs_ptr_str_encoderConfig;
+	uint8_t u8_state;
+	
+	if(ptr_str_config == NULL)
+	{
+		//encoder not running
+	}
+	else
+	{
+		u8_state = ENCODER_readState(ptr_str_config);
+		gs_s8_quarterSteps += (sint8_t)pgm_read_byte(&gs_s8_arr_transitions[(gs_u8_lastState << 2) | u8_state]);
+		gs_u8_lastState = u8_state;
+		
+		if(gs_s8_quarterSteps >= ENCODER_STEPS_PER_DETENT)
+		{
+			gs_s8_quarterSteps -= ENCODER_STEPS_PER_DETENT;
+			ENCODER_detent(ptr_str_config, 1);
+		}
+		else if(gs_s8_quarterSteps <= -ENCODER_STEPS_PER_DETENT)
+		{
+			gs_s8_quarterSteps += ENCODER_STEPS_PER_DETENT;
+			ENCODER_detent(ptr_str_config, -1);
+		}
+		else
+		{
+			//between detents
+		}
+	}
+}
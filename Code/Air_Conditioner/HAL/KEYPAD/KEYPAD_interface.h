@@ -14,12 +14,134 @@
 
 
 #include "../../MCAL/DIO/DIO_interface.h"
+#include "../../MCAL/AVR_ARCH/DELAY_interface.h"
+#include "../TIMER_manager/TIMER_manger_interface.h"
+#include "../../MCAL/EXT_INT/EXT_INT_interface.h"
+#include "../../MCAL/AVR_ARCH/PGM_interface.h"
 
-/** Maximum number of rows in the keypad matrix. */
+/** Number of rows in the keypad matrix, 1 to 8, the build may override it. */
+#ifndef KEYPAD_ROWS_MAX
 #define KEYPAD_ROWS_MAX             4
+#endif
 
-/** Maximum number of columns in the keypad matrix. */
+/** Number of columns in the keypad matrix, 1 to 8, the build may override it. */
+#ifndef KEYPAD_COLS_MAX
 #define KEYPAD_COLS_MAX             3
+#endif
+
+#if (KEYPAD_ROWS_MAX < 1) || (KEYPAD_ROWS_MAX > 8) || (KEYPAD_COLS_MAX < 1) || (KEYPAD_COLS_MAX > 8)
+#error keypad geometry, rows and columns must be 1 to 8
+#endif
+
+/**
+ * Number of keys in the matrix. Key n sits on column (n / KEYPAD_ROWS_MAX) and row (n % KEYPAD_ROWS_MAX),
+ * so the keys of one column are KEYPAD_ROWS_MAX adjacent bits of a key map.
+ */
+#define KEYPAD_KEYS_MAX             (KEYPAD_ROWS_MAX * KEYPAD_COLS_MAX)
+
+/** Key map, bit n set when key n is down, the narrowest type that holds every key. */
+#if (KEYPAD_KEYS_MAX <= 8)
+typedef uint8_t keypad_key_map_t;
+#elif (KEYPAD_KEYS_MAX <= 16)
+typedef uint16_t keypad_key_map_t;
+#elif (KEYPAD_KEYS_MAX <= 32)
+typedef uint32_t keypad_key_map_t;
+#else
+typedef uint64_t keypad_key_map_t;
+#endif
+
+/** Key map bit of the key with index INDEX. */
+#define KEYPAD_KEY_BIT(INDEX)       ((keypad_key_map_t)((keypad_key_map_t)1 << (INDEX)))
+
+/** Key map with every bit set. */
+#define KEYPAD_KEY_MAP_ALL          ((keypad_key_map_t)~(keypad_key_map_t)0)
+
+/** Key value returned when no key is available. */
+#define KEYPAD_NO_KEY               'N'
+
+/** Timer driving the background scan. */
+#define KEYPAD_SCAN_TIMER                   TIMER_2
+
+/** Period of the scan tick in milliseconds, one column is sampled per tick. */
+#define KEYPAD_SCAN_TICK_MS                 1UL
+
+/** Clock of the scan timer and its division ratio: F_CPU / 64 up to 16.384 MHz, F_CPU / 128 above, so the 8-bit timer reaches a full tick. */
+#if ((((F_CPU / 64UL) * KEYPAD_SCAN_TICK_MS) + 999UL) / 1000UL) <= 256UL
+#define KEYPAD_SCAN_TIMER_PRESCALER         F_CPU_64
+#define KEYPAD_SCAN_TIMER_PRESCALER_DIV     64UL
+#else
+#define KEYPAD_SCAN_TIMER_PRESCALER         F_CPU_128
+#define KEYPAD_SCAN_TIMER_PRESCALER_DIV     128UL
+#endif
+
+/** Timer counts of one scan tick at F_CPU, rounded up so a tick is never shorter than KEYPAD_SCAN_TICK_MS. */
+#define KEYPAD_SCAN_TICK_COUNTS             ((((F_CPU / KEYPAD_SCAN_TIMER_PRESCALER_DIV) * KEYPAD_SCAN_TICK_MS) + 999UL) / 1000UL)
+
+#if (KEYPAD_SCAN_TICK_COUNTS < 2) || (KEYPAD_SCAN_TICK_COUNTS > 256)
+#error Keypad scan tick compare value, 1 to 255 for the 8-bit timer: change KEYPAD_SCAN_TICK_MS
+#endif
+
+/** Compare value for one scan tick at F_CPU. */
+#define KEYPAD_SCAN_TICK_COMPARE_VALUE      ((uint16_t)(KEYPAD_SCAN_TICK_COUNTS - 1UL))
+
+/** Time of one full matrix sweep in milliseconds, the period of the gesture timing. */
+#define KEYPAD_SWEEP_MS                     (KEYPAD_SCAN_TICK_MS * KEYPAD_COLS_MAX)
+
+/** Press time before a hold (long-press) event is reported, auto-repeat starts after it. */
+#define KEYPAD_HOLD_MS                      500UL
+
+/** Full matrix sweeps before a hold event is reported. */
+#define KEYPAD_HOLD_SWEEPS                  ((uint16_t)(KEYPAD_HOLD_MS / KEYPAD_SWEEP_MS))
+
+/** Time from the hold event to the first repeat event. */
+#define KEYPAD_REPEAT_START_MS              300UL
+
+/** Shortest time between two repeat events. */
+#define KEYPAD_REPEAT_MIN_MS                60UL
+
+/** Amount each repeat shortens the time to the next one, until KEYPAD_REPEAT_MIN_MS is reached. */
+#define KEYPAD_REPEAT_STEP_MS               30UL
+
+/** Repeat periods in full matrix sweeps. */
+#define KEYPAD_REPEAT_START_SWEEPS          ((uint8_t)(KEYPAD_REPEAT_START_MS / KEYPAD_SWEEP_MS))
+#define KEYPAD_REPEAT_MIN_SWEEPS            ((uint8_t)(KEYPAD_REPEAT_MIN_MS / KEYPAD_SWEEP_MS))
+#define KEYPAD_REPEAT_STEP_SWEEPS           ((uint8_t)(KEYPAD_REPEAT_STEP_MS / KEYPAD_SWEEP_MS))
+
+/** Highest repeat count, later repeats keep this count. */
+#define KEYPAD_REPEAT_COUNT_MAX             0xFF
+
+/** Number of entries in the event queue (power of 2). */
+#define KEYPAD_EVENT_QUEUE_SIZE             16
+
+/** Index mask of the event queue. */
+#define KEYPAD_EVENT_QUEUE_MASK             (KEYPAD_EVENT_QUEUE_SIZE - 1)
+
+/** Position of the event type in a queue entry, the key index sits below it. */
+#define KEYPAD_EVENT_TYPE_SHIFT             6
+
+/** Mask of the key index in a queue entry. */
+#define KEYPAD_EVENT_KEY_MASK               ((uint8_t)0x3F)
+
+/** Record the press latency and the scan cost. Off unless the build defines it to TRUE. */
+#ifndef KEYPAD_INSTRUMENTATION
+#define KEYPAD_INSTRUMENTATION              FALSE
+#endif
+
+#if KEYPAD_INSTRUMENTATION == TRUE
+
+/** Scan timer counts per millisecond, the resolution of the time stamps. */
+#define KEYPAD_INSTR_COUNTS_PER_MS          ((uint32_t)(KEYPAD_SCAN_TICK_COMPARE_VALUE + 1UL) / KEYPAD_SCAN_TICK_MS)
+
+/** Length of one scan timer count in microseconds. */
+#define KEYPAD_INSTR_COUNT_US               ((KEYPAD_SCAN_TIMER_PRESCALER_DIV * 1000000UL) / F_CPU)
+
+/** Number of bins of the press-to-action latency histogram. */
+#define KEYPAD_INSTR_HIST_BINS              8
+
+/** Width of one histogram bin in milliseconds. */
+#define KEYPAD_INSTR_HIST_BIN_MS            16UL
+
+#endif
 
 /** Structure to represent a single unit of the keypad (a pin). */
 typedef struct
@@ -28,11 +150,21 @@ typedef struct
 	dio_enu_pin_t enu_pin;   /**< Pin of the keypad pin. */
 }keypad_str_unit_t;
 
+/** Enumeration of the scan modes. */
+typedef enum
+{
+	KEYPAD_SCAN_CONTINUOUS = 0,  /**< The matrix is scanned on every tick. */
+	KEYPAD_SCAN_WAKE_ON_PRESS    /**< The scan sleeps with all columns low until a row edge raises enu_wake_int. */
+}keypad_enu_scan_t;
+
 /** Configuration structure for the keypad module. */
 typedef struct
 {
     keypad_str_unit_t str_row_pins[KEYPAD_ROWS_MAX]; /**< Array of row pins configuration. */
 	keypad_str_unit_t str_col_pins[KEYPAD_COLS_MAX]; /**< Array of column pins configuration. */
+	const uint8_t *ptr_u8_keymap;                    /**< Key codes in flash (PROGMEM), KEYPAD_ROWS_MAX rows of KEYPAD_COLS_MAX codes, NULL selects the built-in 4x3 or 4x4 layout. */
+	keypad_enu_scan_t enu_scan;                      /**< Scan mode. */
+	ext_int_enu_source_t enu_wake_int;               /**< Interrupt the rows are wired-AND to (one diode per row), used by KEYPAD_SCAN_WAKE_ON_PRESS, KEYPAD_init() fails if another driver holds it. */
 }keypad_str_config_t;
 
 
@@ -44,27 +176,163 @@ typedef enum{
 		KEYPAD_NO_DATA     /**< No key data found. */
 }keypad_enu_return_state_t;
 
+/** Enumeration of the key events reported by the background scan. */
+typedef enum{
+		KEYPAD_EVENT_PRESS = 0,   /**< The key went down. */
+		KEYPAD_EVENT_RELEASE,     /**< The key went up. */
+		KEYPAD_EVENT_HOLD,        /**< Long press: the key has been down for KEYPAD_HOLD_MS. */
+		KEYPAD_EVENT_REPEAT       /**< Auto-repeat while the key stays down after the hold, at a rising rate. */
+}keypad_enu_event_t;
+
+/** Structure to represent one key event. */
+typedef struct
+{
+	uint8_t u8_key;              /**< Character of the key. */
+	keypad_enu_event_t enu_event; /**< What happened to the key. */
+	uint16_t u16_time_ms;        /**< Scan time of the event in milliseconds, wraps around. The wake-on-press scan pauses it while asleep. */
+	uint8_t u8_repeat;           /**< Number of the repeat, from 1 up to KEYPAD_REPEAT_COUNT_MAX, 0 for the other events. */
+}keypad_str_event_t;
+
+#if KEYPAD_INSTRUMENTATION == TRUE
+
+/** Summary of one measured quantity. */
+typedef struct
+{
+	uint32_t u32_min_us;   /**< Shortest sample in microseconds, 0 before the first sample. */
+	uint32_t u32_max_us;   /**< Longest sample in microseconds. */
+	uint32_t u32_mean_us;  /**< Mean in microseconds, older samples weigh less once the count saturates. */
+	uint16_t u16_count;    /**< Number of samples, halved together with the sum when it saturates. */
+}keypad_str_stat_t;
+
+/**
+ * Keypad timing statistics.
+ *
+ * A press is time stamped at the first scan sample that sees it, at its acceptance by the debounce, and when
+ * the reader takes its event. Bounce during a press keeps the first stamp; a change that does not last two
+ * sweeps is forgotten.
+ */
+typedef struct
+{
+	keypad_str_stat_t str_scan;       /**< Cost of one scan tick. */
+	keypad_str_stat_t str_read;       /**< Cost of one KEYPAD_read() call. */
+	keypad_str_stat_t str_debounce;   /**< First edge of a press to its acceptance. */
+	keypad_str_stat_t str_latency;    /**< First edge of a press to the reader taking its event (press to action). */
+	uint16_t u16_arr_latency_hist[KEYPAD_INSTR_HIST_BINS]; /**< Press-to-action latencies, KEYPAD_INSTR_HIST_BIN_MS per bin, the last bin also holds the longer ones. */
+}keypad_str_stats_t;
+
+#endif
+
 /**
  * @brief Initialize the keypad.
  *
- * This function initializes the keypad by configuring row pins as inputs and column pins as outputs.
+ * This function initializes the keypad by configuring row pins as inputs and column pins as outputs,
+ * then starts the background scan on KEYPAD_SCAN_TIMER. The configuration must stay valid while the scan runs.
  *
  * @param[in] ptr_str_keypad_config Pointer to the keypad configuration structure.
- * @return Operation status: KEYPAD_E_OK if successful, KEYPAD_E_NOT_OK if initialization failed.
+ * @return Operation status: KEYPAD_E_OK if successful, KEYPAD_E_NOT_OK if initialization failed or the
+ *         geometry has no built-in layout and no key map is given.
  */
 keypad_enu_return_state_t KEYPAD_init(keypad_str_config_t *ptr_str_keypad_config);
 
 /**
  * @brief Read key input from the keypad.
  *
- * This function reads the key input from the keypad by scanning rows and columns.
+ * This function returns the next key press reported by the background scan without waiting.
+ * Release and hold events queued before it are dropped.
  *
  * @param[in] ptr_str_keypad_config Pointer to the keypad configuration structure.
- * @param[out] ptr_u8_data Pointer to store the read key data.
+ * @param[out] ptr_u8_data Pointer to store the read key data, KEYPAD_NO_KEY when no press is queued.
  * @return Operation status: KEYPAD_E_OK if successful, KEYPAD_NULL_PTR if NULL pointer provided, KEYPAD_NO_DATA if no key data found.
  */
 keypad_enu_return_state_t KEYPAD_read(keypad_str_config_t *ptr_str_keypad_config, uint8_t *ptr_u8_data);
 
+/**
+ * @brief Read the next key event from the keypad.
+ *
+ * This function pops the oldest press, release or hold event reported by the background scan without waiting.
+ *
+ * @param[in] ptr_str_keypad_config Pointer to the keypad configuration structure.
+ * @param[out] ptr_str_event Pointer to store the event.
+ * @return Operation status: KEYPAD_E_OK if successful, KEYPAD_NULL_PTR if NULL pointer provided, KEYPAD_NO_DATA if no event is queued.
+ */
+keypad_enu_return_state_t KEYPAD_readEvent(keypad_str_config_t *ptr_str_keypad_config, keypad_str_event_t *ptr_str_event);
+
+/**
+ * @brief Read the debounced state of every key.
+ *
+ * The map is taken from one full sweep, so any number of keys held together are reported, which lets the
+ * caller detect chords.
+ *
+ * @param[in] ptr_str_keypad_config Pointer to the keypad configuration structure.
+ * @param[out] ptr_key_map Pointer to store the key map, bit n set when key n is down.
+ * @return Operation status: KEYPAD_E_OK if successful, KEYPAD_NULL_PTR if NULL pointer provided.
+ */
+keypad_enu_return_state_t KEYPAD_readKeys(keypad_str_config_t *ptr_str_keypad_config, keypad_key_map_t *ptr_key_map);
+
+/**
+ * @brief Get the key map bit of a key code.
+ *
+ * Chords are tested by OR-ing the bits of their keys and comparing them with the map from KEYPAD_readKeys().
+ *
+ * @param[in] ptr_str_keypad_config Pointer to the keypad configuration structure.
+ * @param[in] copy_u8_key Key code as found in the key map table.
+ * @param[out] ptr_key_map Pointer to store the bit of the key.
+ * @return Operation status: KEYPAD_E_OK if successful, KEYPAD_NULL_PTR if NULL pointer provided,
+ *         KEYPAD_NO_DATA if no key has this code.
+ */
+keypad_enu_return_state_t KEYPAD_keyBit(keypad_str_config_t *ptr_str_keypad_config, uint8_t copy_u8_key, keypad_key_map_t *ptr_key_map);
+
+/**
+ * @brief Read the scan time.
+ *
+ * The scan tick counts milliseconds, so other modules can use it as a time base. It wraps around and
+ * pauses while the wake-on-press scan sleeps.
+ *
+ * @param[in] ptr_str_keypad_config Pointer to the keypad configuration structure.
+ * @param[out] ptr_u16_time_ms Pointer to store the scan time in milliseconds.
+ * @return Operation status: KEYPAD_E_OK if successful, KEYPAD_NULL_PTR if NULL pointer provided.
+ */
+keypad_enu_return_state_t KEYPAD_readTime(keypad_str_config_t *ptr_str_keypad_config, uint16_t *ptr_u16_time_ms);
+
+/**
+ * @brief Check whether the keypad has nothing for the caller.
+ *
+ * A running scan does not count: its tick wakes the CPU from idle sleep, and a key it accepts is queued before
+ * the CPU returns to the caller. In KEYPAD_SCAN_WAKE_ON_PRESS mode the scan timer also stops once all keys are
+ * released, so the CPU sleeps until the next key press.
+ *
+ * @param[in] ptr_str_keypad_config Pointer to the keypad configuration structure.
+ * @param[out] ptr_u8_idle TRUE when no event is queued, FALSE otherwise.
+ * @return Operation status: KEYPAD_E_OK if successful, KEYPAD_NULL_PTR if NULL pointer provided.
+ */
+keypad_enu_return_state_t KEYPAD_isIdle(keypad_str_config_t *ptr_str_keypad_config, uint8_t *ptr_u8_idle);
+
+#if KEYPAD_INSTRUMENTATION == TRUE
+
+/**
+ * @brief Read the timing statistics.
+ *
+ * Time stamps come from the scan timer, so they have a resolution of KEYPAD_INSTR_COUNT_US and stop while the
+ * wake-on-press scan sleeps. Call it from the same context as KEYPAD_read().
+ *
+ * @param[in] ptr_str_keypad_config Pointer to the keypad configuration structure.
+ * @param[out] ptr_str_stats Pointer to store the statistics.
+ * @return Operation status: KEYPAD_E_OK if successful, KEYPAD_NULL_PTR if NULL pointer provided.
+ */
+keypad_enu_return_state_t KEYPAD_readStats(keypad_str_config_t *ptr_str_keypad_config, keypad_str_stats_t *ptr_str_stats);
+
+/**
+ * @brief Clear the timing statistics.
+ *
+ * The reader side is cleared at once, the scan side at the next scan tick.
+ *
+ * @param[in] ptr_str_keypad_config Pointer to the keypad configuration structure.
+ * @return Operation status: KEYPAD_E_OK if successful, KEYPAD_NULL_PTR if NULL pointer provided.
+ */
+keypad_enu_return_state_t KEYPAD_resetStats(keypad_str_config_t *ptr_str_keypad_config);
+
+#endif
+
 
 
 #endif /* KEYPAD_INTERFACE_H	*/
\ No newline at end of file
@@ -3,27 +3,273 @@
  * @brief Keypad module implementation.
  *
  * This file contains the implementation of the keypad module functions for initialization and reading key inputs.
+ * The matrix is scanned in the background from a timer interrupt, one column per tick. Every key is debounced
+ * by a 2-bit vertical counter, so a change is accepted after 4 equal samples, and the resulting events are
+ * passed to the reader through a single-producer single-consumer queue. A key held down reports a hold
+ * (long-press) event, then repeat events whose period shrinks from KEYPAD_REPEAT_START_MS to KEYPAD_REPEAT_MIN_MS. In the wake-on-press mode the scan
+ * stops once all keys are released and waits, with every column low, for a row edge on an external interrupt.
+ * With KEYPAD_INSTRUMENTATION each press is time stamped from the scan timer on its way to the reader.
  *
  * @date 22/8/2023
  * @author Arafa Arafa
  */
 
 #include "KEYPAD_interface.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
 
 
 /**
- * @brief Keypad matrix for key mapping.
+ * @brief Built-in key map in flash, used when the configuration gives none.
  *
- * This 2-dimensional array represents the layout of the keypad, where each element corresponds to a key.
- * Rows represent the keypad rows, and columns represent the keypad columns. The characters within the array
- * indicate the keys associated with the respective row and column.
+ * Each row of the table is a row of the keypad and each character is the key on that row and column.
  */
-static uint8_t keypad[KEYPAD_ROWS_MAX][KEYPAD_COLS_MAX] = {
-    {'1', '2', '3'},
-    {'4', '5', '6'},
-    {'7', '8', '9'},
-    {'*', '0', '#'}
+#if (KEYPAD_ROWS_MAX == 4) && (KEYPAD_COLS_MAX == 3)
+static const uint8_t gs_u8_arr_defaultKeymap[KEYPAD_ROWS_MAX * KEYPAD_COLS_MAX] PROGMEM = {
+    '1', '2', '3',
+    '4', '5', '6',
+    '7', '8', '9',
+    '*', '0', '#'
 };
+#define KEYPAD_DEFAULT_KEYMAP		gs_u8_arr_defaultKeymap
+#define KEYPAD_DEFAULT_KEYMAP_FOUND	TRUE
+#elif (KEYPAD_ROWS_MAX == 4) && (KEYPAD_COLS_MAX == 4)
+static const uint8_t gs_u8_arr_defaultKeymap[KEYPAD_ROWS_MAX * KEYPAD_COLS_MAX] PROGMEM = {
+    '1', '2', '3', 'A',
+    '4', '5', '6', 'B',
+    '7', '8', '9', 'C',
+    '*', '0', '#', 'D'
+};
+#define KEYPAD_DEFAULT_KEYMAP		gs_u8_arr_defaultKeymap
+#define KEYPAD_DEFAULT_KEYMAP_FOUND	TRUE
+#else
+#define KEYPAD_DEFAULT_KEYMAP		NULL
+#define KEYPAD_DEFAULT_KEYMAP_FOUND	FALSE
+#endif
+
+/* Key map table of the running scan */
+static const uint8_t *gs_ptr_u8_keymap = NULL;
+
+/* Key index stored when no key is being held */
+#define KEYPAD_KEY_INDEX_NONE		0xFF
+
+/* Configuration scanned by the timer interrupt, NULL while the scan is stopped */
+static keypad_str_config_t * volatile gs_ptr_str_scanConfig = NULL;
+
+/* TRUE while the scan timer runs */
+static volatile uint8_t gs_u8_scanActive = FALSE;
+
+/* TRUE when all rows sit on one port and are sampled with a single read */
+static uint8_t gs_u8_rowsPortRead = FALSE;
+
+/* Column driven low for the current tick */
+static uint8_t gs_u8_scanCol = U8_ZERO_VALUE;
+
+/* Raw samples of the current sweep, bit n set when key n is down */
+static keypad_key_map_t gs_scanSample = U8_ZERO_VALUE;
+
+/* Debounced key states, bit n set when key n is down */
+static volatile keypad_key_map_t gs_keyState = U8_ZERO_VALUE;
+
+/* Vertical counter: bit n of the two maps is the 2-bit counter of key n */
+static keypad_key_map_t gs_debounceCount0 = KEYPAD_KEY_MAP_ALL;
+static keypad_key_map_t gs_debounceCount1 = KEYPAD_KEY_MAP_ALL;
+
+/* Key watched for a hold event and the sweeps it has been down */
+static uint8_t gs_u8_holdKey = KEYPAD_KEY_INDEX_NONE;
+static uint16_t gs_u16_holdSweeps = U8_ZERO_VALUE;
+
+/* Auto-repeat of the held key: current period, sweeps left to the next repeat and repeats so far */
+static uint8_t gs_u8_repeatPeriod = U8_ZERO_VALUE;
+static uint8_t gs_u8_repeatCountdown = U8_ZERO_VALUE;
+static uint8_t gs_u8_repeatCount = U8_ZERO_VALUE;
+
+/* Milliseconds counted by the scan tick, the time stamp of the events */
+static volatile uint16_t gs_u16_scanTimeMs = U8_ZERO_VALUE;
+
+/* Event queue: the head is written only by the scan interrupt, the tail only by the reader */
+static volatile uint8_t gs_u8_arr_eventQueue[KEYPAD_EVENT_QUEUE_SIZE];
+static volatile uint16_t gs_u16_arr_eventTime[KEYPAD_EVENT_QUEUE_SIZE];
+static volatile uint8_t gs_u8_arr_eventRepeat[KEYPAD_EVENT_QUEUE_SIZE];
+static volatile uint8_t gs_u8_eventHead = U8_ZERO_VALUE;
+static volatile uint8_t gs_u8_eventTail = U8_ZERO_VALUE;
+
+static timerm_str_config_t gs_str_scanTimerConfig;
+
+#if KEYPAD_INSTRUMENTATION == TRUE
+
+/* Time stamps wrap together with the scan time */
+#define KEYPAD_INSTR_STAMP_WRAP		((uint32_t)0x10000UL * KEYPAD_INSTR_COUNTS_PER_MS)
+
+/* Minimum of a summary without samples */
+#define KEYPAD_INSTR_MIN_NONE		0xFFFFFFFFUL
+
+/* Highest sample count of a summary */
+#define KEYPAD_INSTR_COUNT_MAX		0xFFFFU
+
+/* Keys of one column in a key map */
+#define KEYPAD_COL_KEYS_MASK		((keypad_key_map_t)(KEYPAD_KEY_BIT(KEYPAD_ROWS_MAX) - 1U))
+
+/* Running summary of one quantity, in scan timer counts */
+typedef struct
+{
+	uint32_t u32_min;
+	uint32_t u32_max;
+	uint32_t u32_sum;
+	uint16_t u16_count;
+}keypad_str_accum_t;
+
+/* Scan side summaries: written by the scan interrupt, which bumps the sequence number after each tick */
+static volatile keypad_str_accum_t gs_str_instrScan;
+static volatile keypad_str_accum_t gs_str_instrDebounce;
+static volatile uint8_t gs_u8_instrSeq = U8_ZERO_VALUE;
+static volatile uint8_t gs_u8_instrResetRequest = FALSE;
+
+/* Time stamp taken at the start of the current scan tick */
+static uint32_t gs_u32_instrTickStart = U8_ZERO_VALUE;
+
+/* Keys with a change seen but not accepted yet, the stamp of their first edge, and the keys that matched their state on the last sweep */
+static keypad_key_map_t gs_instrArmed = U8_ZERO_VALUE;
+static keypad_key_map_t gs_instrSteady = KEYPAD_KEY_MAP_ALL;
+static uint32_t gs_u32_arr_instrEdge[KEYPAD_KEYS_MAX];
+
+/* First edge of the key of each queued event */
+static volatile uint32_t gs_u32_arr_eventEdge[KEYPAD_EVENT_QUEUE_SIZE];
+
+/* Reader side summaries */
+static keypad_str_accum_t gs_str_instrRead;
+static keypad_str_accum_t gs_str_instrLatency;
+static uint16_t gs_u16_arr_instrHist[KEYPAD_INSTR_HIST_BINS];
+
+#endif
+
+/**
+ * @brief Sample the rows of the column driven low.
+ *
+ * @param[in] ptr_str_keypad_config Pointer to the keypad configuration structure.
+ * @return Bit r set when row r reads low (key down).
+ */
+static uint8_t KEYPAD_readRows(keypad_str_config_t *ptr_str_keypad_config);
+
+/**
+ * @brief Run the vertical counters on one full sweep and queue the resulting events.
+ *
+ * @param[in] copy_sample Raw key states of the sweep, bit n set when key n is down.
+ */
+static void KEYPAD_debounce(keypad_key_map_t copy_sample);
+
+/**
+ * @brief Look up the code of a key in the flash key map.
+ *
+ * @param[in] copy_u8_key_index Index of the key in the matrix.
+ * @return Key code.
+ */
+static uint8_t KEYPAD_keyCode(uint8_t copy_u8_key_index);
+
+/**
+ * @brief Queue one event stamped with the scan time, dropped when the queue is full.
+ *
+ * @param[in] copy_u8_key_index Index of the key in the matrix.
+ * @param[in] copy_enu_event Type of the event.
+ * @param[in] copy_u8_repeat Repeat number, 0 for the events other than repeat.
+ */
+static void KEYPAD_pushEvent(uint8_t copy_u8_key_index, keypad_enu_event_t copy_enu_event, uint8_t copy_u8_repeat);
+
+/**
+ * @brief Advance the hold and auto-repeat timing of the held key by one sweep.
+ */
+static void KEYPAD_trackHold(void);
+
+/**
+ * @brief Scan timer callback, samples one column and drives the next one.
+ */
+static void KEYPAD_scanTick(void);
+
+/**
+ * @brief Drive every column to the same level.
+ *
+ * @param[in] ptr_str_keypad_config Pointer to the keypad configuration structure.
+ * @param[in] copy_enu_level Level of the columns.
+ */
+static void KEYPAD_writeColumns(keypad_str_config_t *ptr_str_keypad_config, dio_enu_level_t copy_enu_level);
+
+/**
+ * @brief Stop the scan and arm the wake interrupt with every column low.
+ *
+ * @param[in] ptr_str_keypad_config Pointer to the keypad configuration structure.
+ */
+static void KEYPAD_sleepScan(keypad_str_config_t *ptr_str_keypad_config);
+
+/**
+ * @brief Wake interrupt callback, starts a scan from the first column.
+ */
+static void KEYPAD_wake(void);
+
+#if KEYPAD_INSTRUMENTATION == TRUE
+
+/**
+ * @brief Take a time stamp from the scan time and the scan timer count.
+ *
+ * @return Time stamp in scan timer counts, wraps at KEYPAD_INSTR_STAMP_WRAP.
+ */
+static uint32_t KEYPAD_instrStamp(void);
+
+/**
+ * @brief Time between two stamps.
+ *
+ * @param[in] copy_u32_from Earlier stamp.
+ * @param[in] copy_u32_to Later stamp.
+ * @return Elapsed scan timer counts.
+ */
+static uint32_t KEYPAD_instrElapsed(uint32_t copy_u32_from, uint32_t copy_u32_to);
+
+/**
+ * @brief Empty a summary.
+ *
+ * @param[out] ptr_str_accum Pointer to the summary.
+ */
+static void KEYPAD_instrClear(volatile keypad_str_accum_t *ptr_str_accum);
+
+/**
+ * @brief Add one sample to a summary.
+ *
+ * @param[in,out] ptr_str_accum Pointer to the summary.
+ * @param[in] copy_u32_counts Sample in scan timer counts.
+ */
+static void KEYPAD_instrAdd(volatile keypad_str_accum_t *ptr_str_accum, uint32_t copy_u32_counts);
+
+/**
+ * @brief Convert a summary to microseconds.
+ *
+ * @param[in] ptr_str_accum Pointer to the summary.
+ * @param[out] ptr_str_stat Pointer to store the converted summary.
+ */
+static void KEYPAD_instrReport(const keypad_str_accum_t *ptr_str_accum, keypad_str_stat_t *ptr_str_stat);
+
+/**
+ * @brief Stamp the first edge of the keys of one column that differ from their debounced state.
+ *
+ * @param[in] copy_u8_col Column sampled.
+ * @param[in] copy_u8_rows Rows read low on that column.
+ */
+static void KEYPAD_instrSample(uint8_t copy_u8_col, uint8_t copy_u8_rows);
+
+/**
+ * @brief Forget the edges of the accepted changes and of the changes that did not last.
+ *
+ * @param[in] copy_sample Raw key states of the sweep.
+ * @param[in] copy_changed Keys accepted on this sweep.
+ * @param[in] copy_key_state Debounced key states after this sweep.
+ */
+static void KEYPAD_instrSettle(keypad_key_map_t copy_sample, keypad_key_map_t copy_changed, keypad_key_map_t copy_key_state);
+
+/**
+ * @brief Record a press consumed by the reader.
+ *
+ * @param[in] copy_u32_edge Stamp of the first edge of the press.
+ */
+static void KEYPAD_instrConsume(uint32_t copy_u32_edge);
+
+#endif
 	
 
 keypad_enu_return_state_t KEYPAD_init(keypad_str_config_t *ptr_str_keypad_config)
@@ -33,17 +279,90 @@ keypad_enu_return_state_t KEYPAD_init(keypad_str_config_t *ptr_str_keypad_config
 	{
 		enu_return_state=KEYPAD_E_NOT_OK;
 	}
+	else if((ptr_str_keypad_config->ptr_u8_keymap == NULL) && (KEYPAD_DEFAULT_KEYMAP_FOUND == FALSE))
+	{
+		enu_return_state=KEYPAD_E_NOT_OK;
+	}
+	else if((ptr_str_keypad_config->enu_scan == KEYPAD_SCAN_WAKE_ON_PRESS)
+	&& (EXT_INT_init(ptr_str_keypad_config->enu_wake_int, EXT_INT_FALLING_EDGE, KEYPAD_wake) != EXT_INT_E_OK))
+	{
+		enu_return_state=KEYPAD_E_NOT_OK;
+	}
 	else
 	{
+		/* stop a running scan before the configuration and the state change under it */
+		gs_ptr_str_scanConfig = NULL;
 		
+		if(ptr_str_keypad_config->ptr_u8_keymap != NULL)
+		{
+			gs_ptr_u8_keymap = ptr_str_keypad_config->ptr_u8_keymap;
+		}
+		else
+		{
+			gs_ptr_u8_keymap = KEYPAD_DEFAULT_KEYMAP;
+		}
+		
+		gs_u8_rowsPortRead = TRUE;
 		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < KEYPAD_ROWS_MAX; u8_counter++){
 			DIO_init(ptr_str_keypad_config->str_row_pins[u8_counter].enu_port, ptr_str_keypad_config->str_row_pins[u8_counter].enu_pin, DIO_PIN_INPUT);
 			DIO_write_pin(ptr_str_keypad_config->str_row_pins[u8_counter].enu_port, ptr_str_keypad_config->str_row_pins[u8_counter].enu_pin, DIO_PIN_HIGH_LEVEL);
+			if(ptr_str_keypad_config->str_row_pins[u8_counter].enu_port != ptr_str_keypad_config->str_row_pins[U8_ZERO_VALUE].enu_port)
+			{
+				gs_u8_rowsPortRead = FALSE;
+			}
 		}
 		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < KEYPAD_COLS_MAX; u8_counter++){
 			DIO_init(ptr_str_keypad_config->str_col_pins[u8_counter].enu_port, ptr_str_keypad_config->str_col_pins[u8_counter].enu_pin, DIO_PIN_OUTPUT);
 			DIO_write_pin(ptr_str_keypad_config->str_col_pins[u8_counter].enu_port, ptr_str_keypad_config->str_col_pins[u8_counter].enu_pin, DIO_PIN_HIGH_LEVEL);
 		}
+		
+		gs_u8_scanCol = U8_ZERO_VALUE;
+		gs_scanSample = U8_ZERO_VALUE;
+		gs_keyState = U8_ZERO_VALUE;
+		gs_debounceCount0 = KEYPAD_KEY_MAP_ALL;
+		gs_debounceCount1 = KEYPAD_KEY_MAP_ALL;
+		gs_u8_holdKey = KEYPAD_KEY_INDEX_NONE;
+		gs_u16_holdSweeps = U8_ZERO_VALUE;
+		gs_u8_eventHead = U8_ZERO_VALUE;
+		gs_u8_eventTail = U8_ZERO_VALUE;
+		
+#if KEYPAD_INSTRUMENTATION == TRUE
+		KEYPAD_instrClear(&gs_str_instrScan);
+		KEYPAD_instrClear(&gs_str_instrDebounce);
+		KEYPAD_resetStats(ptr_str_keypad_config);
+		gs_u8_instrResetRequest = FALSE;
+		gs_instrArmed = U8_ZERO_VALUE;
+		gs_instrSteady = KEYPAD_KEY_MAP_ALL;
+#endif
+		
+		gs_str_scanTimerConfig.enu_timer_no = KEYPAD_SCAN_TIMER;
+		gs_str_scanTimerConfig.enu_timer_mode = TIMER_CTC_MODE;
+		gs_str_scanTimerConfig.u16_timer_initial_value = INTIALIZE_TIMER_WITH_ZERO;
+		gs_str_scanTimerConfig.u16_timer_compare_match_value = KEYPAD_SCAN_TICK_COMPARE_VALUE;
+		gs_str_scanTimerConfig.ptr_call_back_func = KEYPAD_scanTick;
+		gs_str_scanTimerConfig.enu_prescaller = KEYPAD_SCAN_TIMER_PRESCALER;
+		if(TIMER_MANGER_init(&gs_str_scanTimerConfig) != TIMERM_E_OK)
+		{
+			enu_return_state = KEYPAD_E_NOT_OK;
+		}
+		else if(ptr_str_keypad_config->enu_scan == KEYPAD_SCAN_WAKE_ON_PRESS)
+		{
+			gs_ptr_str_scanConfig = ptr_str_keypad_config;
+			KEYPAD_sleepScan(ptr_str_keypad_config);
+			sei();
+		}
+		else if(ptr_str_keypad_config->enu_scan == KEYPAD_SCAN_CONTINUOUS)
+		{
+			/* the first column settles until the first tick samples it */
+			DIO_write_pin(ptr_str_keypad_config->str_col_pins[U8_ZERO_VALUE].enu_port, ptr_str_keypad_config->str_col_pins[U8_ZERO_VALUE].enu_pin, DIO_PIN_LOW_LEVEL);
+			gs_ptr_str_scanConfig = ptr_str_keypad_config;
+			gs_u8_scanActive = TRUE;
+			TIMER_MANGER_start(gs_str_scanTimerConfig.enu_prescaller, gs_str_scanTimerConfig.enu_timer_no);
+		}
+		else
+		{
+			enu_return_state = KEYPAD_E_NOT_OK;
+		}
 	}
 	return enu_return_state;
 }
@@ -51,53 +370,658 @@ keypad_enu_return_state_t KEYPAD_init(keypad_str_config_t *ptr_str_keypad_config
 
 keypad_enu_return_state_t KEYPAD_read (keypad_str_config_t *ptr_str_keypad_config, uint8_t *ptr_u8_data){
 	
-	keypad_enu_return_state_t enu_return_state=KEYPAD_E_OK;
-	uint8_t u8_col_counter;
-	uint8_t u8_row_counter;
-	uint8_t	u8_catched_data_flag = U8_ZERO_VALUE;
-	dio_enu_level_t enu_pin_level;
-	
-
+	keypad_enu_return_state_t enu_return_state = KEYPAD_NO_DATA;
+	keypad_str_event_t str_event;
+#if KEYPAD_INSTRUMENTATION == TRUE
+	uint32_t u32_start;
+#endif
 	
 	if((ptr_str_keypad_config == NULL) || (ptr_u8_data == NULL)){
 		enu_return_state = KEYPAD_NULL_PTR;
 	}else{
-		
-		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < KEYPAD_COLS_MAX; u8_counter++){
-			DIO_write_pin(ptr_str_keypad_config->str_col_pins[u8_counter].enu_port, ptr_str_keypad_config->str_col_pins[u8_counter].enu_pin, DIO_PIN_HIGH_LEVEL);
+#if KEYPAD_INSTRUMENTATION == TRUE
+		u32_start = KEYPAD_instrStamp();
+#endif
+		*ptr_u8_data = KEYPAD_NO_KEY;
+		while((enu_return_state == KEYPAD_NO_DATA) && (KEYPAD_readEvent(ptr_str_keypad_config, &str_event) == KEYPAD_E_OK))
+		{
+			if(str_event.enu_event == KEYPAD_EVENT_PRESS)
+			{
+				*ptr_u8_data = str_event.u8_key;
+				enu_return_state = KEYPAD_E_OK;
+			}
+			else
+			{
+				//release and hold are not reported here
+			}
 		}
+#if KEYPAD_INSTRUMENTATION == TRUE
+		KEYPAD_instrAdd(&gs_str_instrRead, KEYPAD_instrElapsed(u32_start, KEYPAD_instrStamp()));
+#endif
+	}
+	return enu_return_state;
+}
+
+
+keypad_enu_return_state_t KEYPAD_readEvent(keypad_str_config_t *ptr_str_keypad_config, keypad_str_event_t *ptr_str_event)
+{
+	keypad_enu_return_state_t enu_return_state = KEYPAD_E_OK;
+	uint8_t u8_entry;
+	uint8_t u8_key_index;
+	
+	if((ptr_str_keypad_config == NULL) || (ptr_str_event == NULL))
+	{
+		enu_return_state = KEYPAD_NULL_PTR;
+	}
+	else if(gs_u8_eventTail == gs_u8_eventHead)
+	{
+		enu_return_state = KEYPAD_NO_DATA;
+	}
+	else
+	{
+		u8_entry = gs_u8_arr_eventQueue[gs_u8_eventTail];
 		
-		for(u8_col_counter = U8_ZERO_VALUE; (u8_col_counter < KEYPAD_COLS_MAX) && (u8_catched_data_flag != U8_ONE_VALUE); u8_col_counter++)
+		u8_key_index = u8_entry & KEYPAD_EVENT_KEY_MASK;
+		ptr_str_event->u8_key = KEYPAD_keyCode(u8_key_index);
+		ptr_str_event->enu_event = (keypad_enu_event_t)(u8_entry >> KEYPAD_EVENT_TYPE_SHIFT);
+		ptr_str_event->u16_time_ms = gs_u16_arr_eventTime[gs_u8_eventTail];
+		ptr_str_event->u8_repeat = gs_u8_arr_eventRepeat[gs_u8_eventTail];
+#if KEYPAD_INSTRUMENTATION == TRUE
+		if(ptr_str_event->enu_event == KEYPAD_EVENT_PRESS)
+		{
+			KEYPAD_instrConsume(gs_u32_arr_eventEdge[gs_u8_eventTail]);
+		}
+		else
+		{
+			//only presses lead to an action
+		}
+#endif
+		/* the slot is handed back to the scan only after it has been read */
+		gs_u8_eventTail = (gs_u8_eventTail + U8_ONE_VALUE) & KEYPAD_EVENT_QUEUE_MASK;
+	}
+	return enu_return_state;
+}
+
+
+keypad_enu_return_state_t KEYPAD_readKeys(keypad_str_config_t *ptr_str_keypad_config, keypad_key_map_t *ptr_key_map)
+{
+	keypad_enu_return_state_t enu_return_state = KEYPAD_E_OK;
+	keypad_key_map_t key_map;
+	
+	if((ptr_str_keypad_config == NULL) || (ptr_key_map == NULL))
+	{
+		enu_return_state = KEYPAD_NULL_PTR;
+	}
+	else
+	{
+		/* the map is wider than one byte, read it again if a sweep ended in the middle of the read */
+		do
 		{
-			DIO_write_pin(ptr_str_keypad_config->str_col_pins[u8_col_counter].enu_port, ptr_str_keypad_config->str_col_pins[u8_col_counter].enu_pin, DIO_PIN_LOW_LEVEL);
-			for(u8_row_counter = U8_ZERO_VALUE; u8_row_counter<KEYPAD_ROWS_MAX; u8_row_counter++)
+			key_map = gs_keyState;
+		}while(key_map != gs_keyState);
+		*ptr_key_map = key_map;
+	}
+	return enu_return_state;
+}
+
+
+keypad_enu_return_state_t KEYPAD_keyBit(keypad_str_config_t *ptr_str_keypad_config, uint8_t copy_u8_key, keypad_key_map_t *ptr_key_map)
+{
+	keypad_enu_return_state_t enu_return_state = KEYPAD_NO_DATA;
+	
+	if((ptr_str_keypad_config == NULL) || (ptr_key_map == NULL))
+	{
+		enu_return_state = KEYPAD_NULL_PTR;
+	}
+	else
+	{
+		for(uint8_t u8_key_index = U8_ZERO_VALUE; (u8_key_index < KEYPAD_KEYS_MAX) && (enu_return_state == KEYPAD_NO_DATA); u8_key_index++)
+		{
+			if(KEYPAD_keyCode(u8_key_index) == copy_u8_key)
 			{
-				DIO_read_pin(ptr_str_keypad_config->str_row_pins[u8_row_counter].enu_port, ptr_str_keypad_config->str_row_pins[u8_row_counter].enu_pin, &enu_pin_level);
-				if(enu_pin_level == DIO_PIN_LOW_LEVEL)
-				{
-					while(enu_pin_level == DIO_PIN_LOW_LEVEL)
-					{
-						DIO_read_pin(ptr_str_keypad_config->str_row_pins[u8_row_counter].enu_port, ptr_str_keypad_config->str_row_pins[u8_row_counter].enu_pin, &enu_pin_level);
-					}
-					*ptr_u8_data = keypad[u8_row_counter][u8_col_counter];
-					u8_catched_data_flag = U8_ONE_VALUE;
-					break;
-				}
-				
+				*ptr_key_map = KEYPAD_KEY_BIT(u8_key_index);
+				enu_return_state = KEYPAD_E_OK;
+			}
+			else
+			{
+				//keep looking
 			}
-			DIO_write_pin(ptr_str_keypad_config->str_col_pins[u8_col_counter].enu_port, ptr_str_keypad_config->str_col_pins[u8_col_counter].enu_pin, DIO_PIN_HIGH_LEVEL);
 		}
-		
 	}
+	return enu_return_state;
+}
+
+
+keypad_enu_return_state_t KEYPAD_readTime(keypad_str_config_t *ptr_str_keypad_config, uint16_t *ptr_u16_time_ms)
+{
+	keypad_enu_return_state_t enu_return_state = KEYPAD_E_OK;
+	uint16_t u16_time_ms;
 	
-	if(u8_catched_data_flag != U8_ONE_VALUE)
-	{   
-		*ptr_u8_data = 'N';
-		enu_return_state = KEYPAD_NO_DATA;
+	if((ptr_str_keypad_config == NULL) || (ptr_u16_time_ms == NULL))
+	{
+		enu_return_state = KEYPAD_NULL_PTR;
+	}
+	else
+	{
+		/* read again if a tick landed between the two bytes */
+		do
+		{
+			u16_time_ms = gs_u16_scanTimeMs;
+		}while(u16_time_ms != gs_u16_scanTimeMs);
+		*ptr_u16_time_ms = u16_time_ms;
+	}
+	return enu_return_state;
+}
+
+
+keypad_enu_return_state_t KEYPAD_isIdle(keypad_str_config_t *ptr_str_keypad_config, uint8_t *ptr_u8_idle)
+{
+	keypad_enu_return_state_t enu_return_state = KEYPAD_E_OK;
+	
+	if((ptr_str_keypad_config == NULL) || (ptr_u8_idle == NULL))
+	{
+		enu_return_state = KEYPAD_NULL_PTR;
+	}
+	else if(gs_u8_eventTail == gs_u8_eventHead)
+	{
+		*ptr_u8_idle = TRUE;
 	}
 	else
 	{
+		*ptr_u8_idle = FALSE;
+	}
+	return enu_return_state;
+}
+
+
+#if KEYPAD_INSTRUMENTATION == TRUE
+
+keypad_enu_return_state_t KEYPAD_readStats(keypad_str_config_t *ptr_str_keypad_config, keypad_str_stats_t *ptr_str_stats)
+{
+	keypad_enu_return_state_t enu_return_state = KEYPAD_E_OK;
+	keypad_str_accum_t str_scan;
+	keypad_str_accum_t str_debounce;
+	uint8_t u8_seq;
+	
+	if((ptr_str_keypad_config == NULL) || (ptr_str_stats == NULL))
+	{
+		enu_return_state = KEYPAD_NULL_PTR;
+	}
+	else
+	{
+		/* copy again if a scan tick updated the scan side in the middle of the copy */
+		do
+		{
+			u8_seq = gs_u8_instrSeq;
+			str_scan = gs_str_instrScan;
+			str_debounce = gs_str_instrDebounce;
+		}while(u8_seq != gs_u8_instrSeq);
 		
+		KEYPAD_instrReport(&str_scan, &ptr_str_stats->str_scan);
+		KEYPAD_instrReport(&str_debounce, &ptr_str_stats->str_debounce);
+		KEYPAD_instrReport(&gs_str_instrRead, &ptr_str_stats->str_read);
+		KEYPAD_instrReport(&gs_str_instrLatency, &ptr_str_stats->str_latency);
+		for(uint8_t u8_bin = U8_ZERO_VALUE; u8_bin < KEYPAD_INSTR_HIST_BINS; u8_bin++)
+		{
+			ptr_str_stats->u16_arr_latency_hist[u8_bin] = gs_u16_arr_instrHist[u8_bin];
+		}
 	}
 	return enu_return_state;
-}
\ No newline at end of file
+}
+
+
+keypad_enu_return_state_t KEYPAD_resetStats(keypad_str_config_t *ptr_str_keypad_config)
+{
+	keypad_enu_return_state_t enu_return_state = KEYPAD_E_OK;
+	
+	if(ptr_str_keypad_config == NULL)
+	{
+		enu_return_state = KEYPAD_NULL_PTR;
+	}
+	else
+	{
+		KEYPAD_instrClear(&gs_str_instrRead);
+		KEYPAD_instrClear(&gs_str_instrLatency);
+		for(uint8_t u8_bin = U8_ZERO_VALUE; u8_bin < KEYPAD_INSTR_HIST_BINS; u8_bin++)
+		{
+			gs_u16_arr_instrHist[u8_bin] = U8_ZERO_VALUE;
+		}
+		/* the scan side belongs to the interrupt, it clears it on its next tick */
+		gs_u8_instrResetRequest = TRUE;
+	}
+	return enu_return_state;
+}
+
+#endif
+
+
+static void KEYPAD_writeColumns(keypad_str_config_t *ptr_str_keypad_config, dio_enu_level_t copy_enu_level)
+{
+	for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < KEYPAD_COLS_MAX; u8_counter++)
+	{
+		DIO_write_pin(ptr_str_keypad_config->str_col_pins[u8_counter].enu_port, ptr_str_keypad_config->str_col_pins[u8_counter].enu_pin, copy_enu_level);
+	}
+}
+
+static void KEYPAD_sleepScan(keypad_str_config_t *ptr_str_keypad_config)
+{
+	TIMER_MANGER_stop(KEYPAD_SCAN_TIMER);
+	gs_u8_scanActive = FALSE;
+	/* the flag is cleared before the columns go low, so a key already down latches a new edge and wakes the scan at once */
+	EXT_INT_clearFlag(ptr_str_keypad_config->enu_wake_int);
+	KEYPAD_writeColumns(ptr_str_keypad_config, DIO_PIN_LOW_LEVEL);
+	EXT_INT_enable(ptr_str_keypad_config->enu_wake_int);
+}
+
+static void KEYPAD_wake(void)
+{
+	keypad_str_config_t *ptr_str_config = gs_ptr_str_scanConfig;
+	
+	if(ptr_str_config == NULL)
+	{
+		//scan not configured
+	}
+	else
+	{
+		EXT_INT_disable(ptr_str_config->enu_wake_int);
+		KEYPAD_writeColumns(ptr_str_config, DIO_PIN_HIGH_LEVEL);
+		gs_u8_scanCol = U8_ZERO_VALUE;
+		gs_scanSample = U8_ZERO_VALUE;
+		/* the first column settles until the first tick samples it */
+		DIO_write_pin(ptr_str_config->str_col_pins[U8_ZERO_VALUE].enu_port, ptr_str_config->str_col_pins[U8_ZERO_VALUE].enu_pin, DIO_PIN_LOW_LEVEL);
+		gs_u8_scanActive = TRUE;
+		TIMER_MANGER_setValue(KEYPAD_SCAN_TIMER, INTIALIZE_TIMER_WITH_ZERO);
+		TIMER_MANGER_start(gs_str_scanTimerConfig.enu_prescaller, gs_str_scanTimerConfig.enu_timer_no);
+	}
+}
+
+static uint8_t KEYPAD_keyCode(uint8_t copy_u8_key_index)
+{
+	uint8_t u8_row = copy_u8_key_index % KEYPAD_ROWS_MAX;
+	uint8_t u8_col = copy_u8_key_index / KEYPAD_ROWS_MAX;
+	
+	return pgm_read_byte(&gs_ptr_u8_keymap[(u8_row * KEYPAD_COLS_MAX) + u8_col]);
+}
+
+static uint8_t KEYPAD_readRows(keypad_str_config_t *ptr_str_keypad_config)
+{
+	uint8_t u8_rows = U8_ZERO_VALUE;
+	uint8_t u8_port_value = U8_ZERO_VALUE;
+	dio_enu_level_t enu_pin_level = DIO_PIN_HIGH_LEVEL;
+	
+	if(gs_u8_rowsPortRead == TRUE)
+	{
+		DIO_read_port(ptr_str_keypad_config->str_row_pins[U8_ZERO_VALUE].enu_port, &u8_port_value);
+	}
+	else
+	{
+		//rows read pin by pin below
+	}
+	for(uint8_t u8_row_counter = U8_ZERO_VALUE; u8_row_counter < KEYPAD_ROWS_MAX; u8_row_counter++)
+	{
+		if(gs_u8_rowsPortRead == TRUE)
+		{
+			enu_pin_level = (dio_enu_level_t)READ_BIT(u8_port_value, ptr_str_keypad_config->str_row_pins[u8_row_counter].enu_pin);
+		}
+		else
+		{
+			DIO_read_pin(ptr_str_keypad_config->str_row_pins[u8_row_counter].enu_port, ptr_str_keypad_config->str_row_pins[u8_row_counter].enu_pin, &enu_pin_level);
+		}
+		if(enu_pin_level == DIO_PIN_LOW_LEVEL)
+		{
+			SET_BIT(u8_rows, u8_row_counter);
+		}
+		else
+		{
+			//row idle
+		}
+	}
+	return u8_rows;
+}
+
+static void KEYPAD_pushEvent(uint8_t copy_u8_key_index, keypad_enu_event_t copy_enu_event, uint8_t copy_u8_repeat)
+{
+	uint8_t u8_next_head = (gs_u8_eventHead + U8_ONE_VALUE) & KEYPAD_EVENT_QUEUE_MASK;
+	if(u8_next_head != gs_u8_eventTail)
+	{
+		/* the entry is complete before the head publishes it */
+		gs_u8_arr_eventQueue[gs_u8_eventHead] = (uint8_t)((copy_enu_event << KEYPAD_EVENT_TYPE_SHIFT) | (copy_u8_key_index & KEYPAD_EVENT_KEY_MASK));
+		gs_u16_arr_eventTime[gs_u8_eventHead] = gs_u16_scanTimeMs;
+		gs_u8_arr_eventRepeat[gs_u8_eventHead] = copy_u8_repeat;
+#if KEYPAD_INSTRUMENTATION == TRUE
+		gs_u32_arr_eventEdge[gs_u8_eventHead] = gs_u32_arr_instrEdge[copy_u8_key_index];
+#endif
+		gs_u8_eventHead = u8_next_head;
+	}
+	else
+	{
+		//queue full, the event is dropped
+	}
+}
+
+static void KEYPAD_debounce(keypad_key_map_t copy_sample)
+{
+	keypad_key_map_t key_state = gs_keyState;
+	keypad_key_map_t changed = key_state ^ copy_sample;
+	keypad_key_map_t key_bit = KEYPAD_KEY_BIT(U8_ZERO_VALUE);
+	
+	/* count down the keys that differ from their debounced state, reload the others */
+	gs_debounceCount0 = (keypad_key_map_t)~(gs_debounceCount0 & changed);
+	gs_debounceCount1 = gs_debounceCount0 ^ (gs_debounceCount1 & changed);
+	/* a counter that wrapped has seen 4 equal samples in a row */
+	changed &= gs_debounceCount0 & gs_debounceCount1;
+	key_state ^= changed;
+	gs_keyState = key_state;
+#if KEYPAD_INSTRUMENTATION == TRUE
+	KEYPAD_instrSettle(copy_sample, changed, key_state);
+#endif
+	
+	/* events are decoded only for the keys that changed, the bit walks up with the index */
+	for(uint8_t u8_key_index = U8_ZERO_VALUE; (u8_key_index < KEYPAD_KEYS_MAX) && (changed != U8_ZERO_VALUE); u8_key_index++)
+	{
+		if((changed & key_bit) == U8_ZERO_VALUE)
+		{
+			//key unchanged
+		}
+		else if((key_state & key_bit) != U8_ZERO_VALUE)
+		{
+			KEYPAD_pushEvent(u8_key_index, KEYPAD_EVENT_PRESS, U8_ZERO_VALUE);
+#if KEYPAD_INSTRUMENTATION == TRUE
+			KEYPAD_instrAdd(&gs_str_instrDebounce, KEYPAD_instrElapsed(gs_u32_arr_instrEdge[u8_key_index], gs_u32_instrTickStart));
+#endif
+			gs_u8_holdKey = u8_key_index;
+			gs_u16_holdSweeps = U8_ZERO_VALUE;
+		}
+		else
+		{
+			KEYPAD_pushEvent(u8_key_index, KEYPAD_EVENT_RELEASE, U8_ZERO_VALUE);
+			if(gs_u8_holdKey == u8_key_index)
+			{
+				gs_u8_holdKey = KEYPAD_KEY_INDEX_NONE;
+			}
+			else
+			{
+				//another key is watched
+			}
+		}
+		changed &= (keypad_key_map_t)~key_bit;
+		key_bit <<= U8_ONE_VALUE;
+	}
+	
+	KEYPAD_trackHold();
+}
+
+static void KEYPAD_trackHold(void)
+{
+	if(gs_u8_holdKey == KEYPAD_KEY_INDEX_NONE)
+	{
+		//no key watched
+	}
+	else if(gs_u16_holdSweeps < KEYPAD_HOLD_SWEEPS)
+	{
+		gs_u16_holdSweeps++;
+		if(gs_u16_holdSweeps == KEYPAD_HOLD_SWEEPS)
+		{
+			KEYPAD_pushEvent(gs_u8_holdKey, KEYPAD_EVENT_HOLD, U8_ZERO_VALUE);
+			gs_u8_repeatPeriod = KEYPAD_REPEAT_START_SWEEPS;
+			gs_u8_repeatCountdown = KEYPAD_REPEAT_START_SWEEPS;
+			gs_u8_repeatCount = U8_ZERO_VALUE;
+		}
+		else
+		{
+			//still counting
+		}
+	}
+	else
+	{
+		gs_u8_repeatCountdown--;
+		if(gs_u8_repeatCountdown == U8_ZERO_VALUE)
+		{
+			if(gs_u8_repeatCount < KEYPAD_REPEAT_COUNT_MAX)
+			{
+				gs_u8_repeatCount++;
+			}
+			else
+			{
+				//count saturated
+			}
+			KEYPAD_pushEvent(gs_u8_holdKey, KEYPAD_EVENT_REPEAT, gs_u8_repeatCount);
+			
+			/* each repeat comes sooner than the last one, down to the shortest period */
+			if(gs_u8_repeatPeriod >= (KEYPAD_REPEAT_MIN_SWEEPS + KEYPAD_REPEAT_STEP_SWEEPS))
+			{
+				gs_u8_repeatPeriod -= KEYPAD_REPEAT_STEP_SWEEPS;
+			}
+			else
+			{
+				gs_u8_repeatPeriod = KEYPAD_REPEAT_MIN_SWEEPS;
+			}
+			gs_u8_repeatCountdown = gs_u8_repeatPeriod;
+		}
+		else
+		{
+			//waiting for the next repeat
+		}
+	}
+}
+
+static void KEYPAD_scanTick(void)
+{
+	keypad_str_config_t *ptr_str_config = gs_ptr_str_scanConfig;
+	uint8_t u8_rows;
+	
+	if((ptr_str_config == NULL) || (gs_u8_scanActive == FALSE))
+	{
+		//scan not running
+	}
+	else
+	{
+		gs_u16_scanTimeMs += KEYPAD_SCAN_TICK_MS;
+#if KEYPAD_INSTRUMENTATION == TRUE
+		gs_u32_instrTickStart = KEYPAD_instrStamp();
+		if(gs_u8_instrResetRequest == TRUE)
+		{
+			KEYPAD_instrClear(&gs_str_instrScan);
+			KEYPAD_instrClear(&gs_str_instrDebounce);
+			gs_u8_instrResetRequest = FALSE;
+		}
+		else
+		{
+			//keep counting
+		}
+#endif
+		u8_rows = KEYPAD_readRows(ptr_str_config);
+#if KEYPAD_INSTRUMENTATION == TRUE
+		KEYPAD_instrSample(gs_u8_scanCol, u8_rows);
+#endif
+		/* the rows of one column are adjacent bits of the map */
+		gs_scanSample |= (keypad_key_map_t)((keypad_key_map_t)u8_rows << (gs_u8_scanCol * KEYPAD_ROWS_MAX));
+		
+		DIO_write_pin(ptr_str_config->str_col_pins[gs_u8_scanCol].enu_port, ptr_str_config->str_col_pins[gs_u8_scanCol].enu_pin, DIO_PIN_HIGH_LEVEL);
+		gs_u8_scanCol++;
+		if(gs_u8_scanCol >= KEYPAD_COLS_MAX)
+		{
+			gs_u8_scanCol = U8_ZERO_VALUE;
+			KEYPAD_debounce(gs_scanSample);
+			/* nothing down, nothing raw and no counter running: the matrix is quiet */
+			if((ptr_str_config->enu_scan == KEYPAD_SCAN_WAKE_ON_PRESS) && (gs_scanSample == U8_ZERO_VALUE) && (gs_keyState == U8_ZERO_VALUE)
+			&& ((keypad_key_map_t)(gs_debounceCount0 & gs_debounceCount1) == KEYPAD_KEY_MAP_ALL))
+			{
+				KEYPAD_sleepScan(ptr_str_config);
+			}
+			else
+			{
+				//keys still to follow
+			}
+			gs_scanSample = U8_ZERO_VALUE;
+		}
+		else
+		{
+			//sweep continues
+		}
+		if(gs_u8_scanActive == TRUE)
+		{
+			/* the next column settles until the next tick samples it */
+			DIO_write_pin(ptr_str_config->str_col_pins[gs_u8_scanCol].enu_port, ptr_str_config->str_col_pins[gs_u8_scanCol].enu_pin, DIO_PIN_LOW_LEVEL);
+		}
+		else
+		{
+			//columns left low for the wake interrupt
+		}
+#if KEYPAD_INSTRUMENTATION == TRUE
+		KEYPAD_instrAdd(&gs_str_instrScan, KEYPAD_instrElapsed(gs_u32_instrTickStart, KEYPAD_instrStamp()));
+		gs_u8_instrSeq++;
+#endif
+	}
+}
+
+#if KEYPAD_INSTRUMENTATION == TRUE
+
+static uint32_t KEYPAD_instrStamp(void)
+{
+	uint16_t u16_time_ms;
+	uint16_t u16_count = U8_ZERO_VALUE;
+	
+	/* read again if a tick landed between the time and the count */
+	do
+	{
+		u16_time_ms = gs_u16_scanTimeMs;
+		TIMER_MANGER_getValue(KEYPAD_SCAN_TIMER, &u16_count);
+	}while(u16_time_ms != gs_u16_scanTimeMs);
+	
+	return ((uint32_t)u16_time_ms * KEYPAD_INSTR_COUNTS_PER_MS) + u16_count;
+}
+
+static uint32_t KEYPAD_instrElapsed(uint32_t copy_u32_from, uint32_t copy_u32_to)
+{
+	uint32_t u32_elapsed = copy_u32_to - copy_u32_from;
+	
+	if(copy_u32_to < copy_u32_from)
+	{
+		/* the scan time wrapped between the stamps */
+		u32_elapsed += KEYPAD_INSTR_STAMP_WRAP;
+	}
+	else
+	{
+		//no wrap
+	}
+	return u32_elapsed;
+}
+
+static void KEYPAD_instrClear(volatile keypad_str_accum_t *ptr_str_accum)
+{
+	ptr_str_accum->u32_min = KEYPAD_INSTR_MIN_NONE;
+	ptr_str_accum->u32_max = U8_ZERO_VALUE;
+	ptr_str_accum->u32_sum = U8_ZERO_VALUE;
+	ptr_str_accum->u16_count = U8_ZERO_VALUE;
+}
+
+static void KEYPAD_instrAdd(volatile keypad_str_accum_t *ptr_str_accum, uint32_t copy_u32_counts)
+{
+	if(copy_u32_counts < ptr_str_accum->u32_min)
+	{
+		ptr_str_accum->u32_min = copy_u32_counts;
+	}
+	else
+	{
+		//not shorter
+	}
+	if(copy_u32_counts > ptr_str_accum->u32_max)
+	{
+		ptr_str_accum->u32_max = copy_u32_counts;
+	}
+	else
+	{
+		//not longer
+	}
+	/* halving the sum and the count keeps the mean and lets the older samples fade */
+	if((ptr_str_accum->u16_count == KEYPAD_INSTR_COUNT_MAX) || (ptr_str_accum->u32_sum > (KEYPAD_INSTR_MIN_NONE - copy_u32_counts)))
+	{
+		ptr_str_accum->u32_sum >>= U8_ONE_VALUE;
+		ptr_str_accum->u16_count >>= U8_ONE_VALUE;
+	}
+	else
+	{
+		//room left
+	}
+	ptr_str_accum->u32_sum += copy_u32_counts;
+	ptr_str_accum->u16_count++;
+}
+
+static void KEYPAD_instrReport(const keypad_str_accum_t *ptr_str_accum, keypad_str_stat_t *ptr_str_stat)
+{
+	if(ptr_str_accum->u16_count == U8_ZERO_VALUE)
+	{
+		ptr_str_stat->u32_min_us = U8_ZERO_VALUE;
+		ptr_str_stat->u32_max_us = U8_ZERO_VALUE;
+		ptr_str_stat->u32_mean_us = U8_ZERO_VALUE;
+	}
+	else
+	{
+		ptr_str_stat->u32_min_us = ptr_str_accum->u32_min * KEYPAD_INSTR_COUNT_US;
+		ptr_str_stat->u32_max_us = ptr_str_accum->u32_max * KEYPAD_INSTR_COUNT_US;
+		/* the remainder keeps the mean finer than one count */
+		ptr_str_stat->u32_mean_us = ((ptr_str_accum->u32_sum / ptr_str_accum->u16_count) * KEYPAD_INSTR_COUNT_US)
+		+ (((ptr_str_accum->u32_sum % ptr_str_accum->u16_count) * KEYPAD_INSTR_COUNT_US) / ptr_str_accum->u16_count);
+	}
+	ptr_str_stat->u16_count = ptr_str_accum->u16_count;
+}
+
+static void KEYPAD_instrSample(uint8_t copy_u8_col, uint8_t copy_u8_rows)
+{
+	uint8_t u8_shift = copy_u8_col * KEYPAD_ROWS_MAX;
+	keypad_key_map_t new_edges = ((keypad_key_map_t)((keypad_key_map_t)copy_u8_rows << u8_shift)) ^ gs_keyState;
+	keypad_key_map_t key_bit = KEYPAD_KEY_BIT(u8_shift);
+	
+	/* the keys of this column that differ, and only the first edge of each change */
+	new_edges &= (keypad_key_map_t)((keypad_key_map_t)KEYPAD_COL_KEYS_MASK << u8_shift) & (keypad_key_map_t)~gs_instrArmed;
+	gs_instrArmed |= new_edges;
+	for(uint8_t u8_key_index = u8_shift; new_edges != U8_ZERO_VALUE; u8_key_index++)
+	{
+		if((new_edges & key_bit) != U8_ZERO_VALUE)
+		{
+			gs_u32_arr_instrEdge[u8_key_index] = gs_u32_instrTickStart;
+			new_edges &= (keypad_key_map_t)~key_bit;
+		}
+		else
+		{
+			//no new edge
+		}
+		key_bit <<= U8_ONE_VALUE;
+	}
+}
+
+static void KEYPAD_instrSettle(keypad_key_map_t copy_sample, keypad_key_map_t copy_changed, keypad_key_map_t copy_key_state)
+{
+	keypad_key_map_t steady = (keypad_key_map_t)~(copy_key_state ^ copy_sample);
+	
+	/* bounce inside a press keeps its first edge, a change back that lasts two sweeps was a glitch */
+	gs_instrArmed &= (keypad_key_map_t)~(copy_changed | (steady & gs_instrSteady));
+	gs_instrSteady = steady;
+}
+
+static void KEYPAD_instrConsume(uint32_t copy_u32_edge)
+{
+	uint32_t u32_latency = KEYPAD_instrElapsed(copy_u32_edge, KEYPAD_instrStamp());
+	uint32_t u32_bin = u32_latency / (KEYPAD_INSTR_HIST_BIN_MS * KEYPAD_INSTR_COUNTS_PER_MS);
+	
+	KEYPAD_instrAdd(&gs_str_instrLatency, u32_latency);
+	if(u32_bin >= KEYPAD_INSTR_HIST_BINS)
+	{
+		u32_bin = KEYPAD_INSTR_HIST_BINS - U8_ONE_VALUE;
+	}
+	else
+	{
+		//inside the histogram
+	}
+	if(gs_u16_arr_instrHist[u32_bin] < KEYPAD_INSTR_COUNT_MAX)
+	{
+		gs_u16_arr_instrHist[u32_bin]++;
+	}
+	else
+	{
+		//bin saturated
+	}
+}
+
+#endif
@@ -29,6 +29,36 @@
  */
 #define LCD_DDRAM_START_ADD_LINE_2		0xC0
 
+/**
+ * @brief DDRAM addresses per line in 2-line mode; the address counter wraps from one line to the other.
+ */
+#define LCD_DDRAM_LINE_LENGTH			0x28
+
+/**
+ * @brief DDRAM address bit that selects the second line.
+ */
+#define LCD_DDRAM_LINE_SELECT			0x40
+
+/**
+ * @brief Instruction class bits, the highest set bit selects the instruction.
+ */
+#define LCD_INSTR_SET_DDRAM				0x80
+#define LCD_INSTR_SET_CGRAM				0x40
+#define LCD_INSTR_FUNCTION_SET			0x20
+#define LCD_INSTR_SHIFT					0x10
+#define LCD_INSTR_DISPLAY_CONTROL		0x08
+#define LCD_INSTR_ENTRY_MODE			0x04
+
+/**
+ * @brief Shift instruction bit: set to shift the display, clear to move the cursor.
+ */
+#define LCD_INSTR_SHIFT_DISPLAY			0x08
+
+/**
+ * @brief Entry mode bit: set to increment the address counter after each access.
+ */
+#define LCD_INSTR_ENTRY_INCREMENT		0x02
+
 /**
  * @brief Command to clear the display.
  */
@@ -119,4 +149,14 @@
  */
 #define LCD_8BITS_2LINES_58DM				0x38
 
+/**
+ * @brief Wake-up instruction of the reset handshake (8-bit function set), sent three times after power-up.
+ */
+#define LCD_CMD_WAKE_UP						0x30
+
+/**
+ * @brief Function set that switches the interface to 4 bits, sent as a single nibble after the wake-up.
+ */
+#define LCD_CMD_WAKE_UP_4_BIT				0x20
+
 #endif /* LCD_CMD_H_ */
\ No newline at end of file
@@ -12,6 +12,11 @@
 #include "LCD_cmd.h"
 #include "../../MCAL/DIO/DIO_interface.h"
 #include "../../STD_LIB/bit_math.h"
+#include "../TIMER_manager/TIMER_manger_interface.h"
+#include "../../MCAL/AVR_ARCH/DELAY_interface.h"
+#include "../../MCAL/AVR_ARCH/PGM_interface.h"
+#include "../../STD_LIB/FORMAT/FORMAT_interface.h"
+#include "../../MCAL/TWI/TWI_interface.h"
 
 // Number of bits in a byte
 #define LCD_1_BYTE							8
@@ -28,6 +33,149 @@
 // Maximum number of data pins modulo 8
 #define LCD_MAX_DATA_PINS_MOD_8				8
 
+// Mask of one nibble
+#define LCD_NIBBLE_MASK						((uint8_t)0x0F)
+
+// Number of rows on the display
+#define LCD_ROWS_MAX						2
+
+// Number of visible columns per row
+#define LCD_COLS_MAX						16
+
+// Character used to blank a cell of the shadow buffer
+#define LCD_BLANK_CHAR						' '
+
+// Bit of a column in a dirty cell mask, unsigned so column 15 does not shift into the sign bit of int
+#define LCD_COL_BIT(COL)					((uint16_t)((uint16_t)1U << (COL)))
+
+// Busy flag reads before LCD_SYNC_BUSY_FLAG gives up and falls back to the fixed delay
+#define LCD_BUSY_FLAG_POLL_MAX				200
+
+// Number of entries in the asynchronous transmit queue (power of 2)
+#define LCD_QUEUE_SIZE						64
+
+// Index mask of the transmit queue
+#define LCD_QUEUE_MASK						(LCD_QUEUE_SIZE - 1)
+
+// Queue entry flag selecting the data register instead of the instruction register
+#define LCD_QUEUE_DATA_FLAG					((uint16_t)0x0100)
+
+// Queue entry flag sending only the high nibble of an instruction (reset handshake)
+#define LCD_QUEUE_NIBBLE_FLAG				((uint16_t)0x0200)
+
+// Queue entry flag holding the queue for the number of ticks in the low byte
+#define LCD_QUEUE_WAIT_FLAG					((uint16_t)0x0400)
+
+// Queue entry flag marking the end of the power-up sequence
+#define LCD_QUEUE_READY_FLAG				((uint16_t)0x0800)
+
+// Timer driving the transmit queue
+#define LCD_QUEUE_TIMER						TIMER_0
+
+// Clock of the transmit queue timer
+#define LCD_QUEUE_TIMER_PRESCALER			F_CPU_8
+
+// Division ratio of LCD_QUEUE_TIMER_PRESCALER
+#define LCD_QUEUE_TIMER_PRESCALER_DIV		8UL
+
+// Period of the queue tick in microseconds
+#define LCD_QUEUE_TICK_US					100UL
+
+// Timer counts of one queue tick at F_CPU, rounded up so a tick is never shorter than LCD_QUEUE_TICK_US
+#define LCD_QUEUE_TICK_COUNTS				((((F_CPU / LCD_QUEUE_TIMER_PRESCALER_DIV) * LCD_QUEUE_TICK_US) + 999999UL) / 1000000UL)
+
+// Compare value for one queue tick at F_CPU
+#define LCD_QUEUE_TICK_COMPARE_VALUE		((uint16_t)(LCD_QUEUE_TICK_COUNTS - 1UL))
+
+#if (LCD_QUEUE_TICK_COUNTS < 2) || (LCD_QUEUE_TICK_COUNTS > 256)
+#error LCD queue tick compare value, 1 to 255 for the 8-bit timer: change LCD_QUEUE_TIMER_PRESCALER or LCD_QUEUE_TICK_US
+#endif
+
+// Highest instruction code that is a clear (0x01) or return home (0x02, 0x03) instruction
+#define LCD_LONG_CMD_MAX					0x03
+
+// Wait after power-up before the first instruction
+#define LCD_POWER_ON_DELAY_MS				40
+
+// Enable pulse width, also covers the data delay of a read (datasheet: 450 ns and 360 ns)
+#define LCD_ENABLE_PULSE_US					1
+
+// Execution time of an instruction other than clear and return home (datasheet: 37 us)
+#define LCD_CMD_EXEC_TIME_US				37
+
+// Execution time of a data write, including the address counter update (datasheet: 37 us + 4 us)
+#define LCD_DATA_EXEC_TIME_US				41
+
+// Execution time of clear and return home (datasheet: 1.52 ms)
+#define LCD_LONG_CMD_EXEC_TIME_US			1520
+
+// Wait after the first wake-up instruction (datasheet: 4.1 ms)
+#define LCD_WAKE_UP_FIRST_DELAY_US			4100
+
+// Wait after the later wake-up instructions (datasheet: 100 us)
+#define LCD_WAKE_UP_DELAY_US				100
+
+// Queue ticks for a wait in microseconds, rounded up
+#define LCD_QUEUE_TICKS(US)					((uint16_t)(((US) + LCD_QUEUE_TICK_US - 1UL) / LCD_QUEUE_TICK_US))
+
+// Longest wait a single queue entry holds, in ticks
+#define LCD_QUEUE_WAIT_MAX					0xFF
+
+// Queue ticks to wait after a clear or return home instruction
+#define LCD_QUEUE_LONG_CMD_TICKS			((uint8_t)((LCD_LONG_CMD_EXEC_TIME_US + LCD_QUEUE_TICK_US - 1UL) / LCD_QUEUE_TICK_US))
+
+// Number of CGRAM character slots
+#define LCD_CGRAM_SLOTS						8
+
+// Pixel rows of a 5x8 glyph
+#define LCD_GLYPH_ROWS						8
+
+// First character code of the CGRAM slots; codes 0x08..0x0F alias slots 0..7 and keep code 0 out of strings
+#define LCD_CGRAM_CODE_BASE					0x08
+
+// Horizontal sub-steps of one bargraph cell (one per pixel column)
+#define LCD_BAR_STEPS_PER_CELL				5
+
+// Character code of the full block in the HD44780 character ROM
+#define LCD_FULL_BLOCK_CHAR					0xFF
+
+// Longest run of unchanged cells that LCD_refresh rewrites instead of sending a new set-address command
+#define LCD_REFRESH_GAP_MAX					1
+
+// PCF8574 backpack wiring: P0 = RS, P1 = RW, P2 = E, P3 = backlight, P4..P7 = D4..D7
+#define LCD_PCF8574_RS						((uint8_t)0x01)
+#define LCD_PCF8574_RW						((uint8_t)0x02)
+#define LCD_PCF8574_E						((uint8_t)0x04)
+#define LCD_PCF8574_BACKLIGHT				((uint8_t)0x08)
+#define LCD_PCF8574_DATA_SHIFT				4
+
+// Usual 7-bit address of a PCF8574 backpack with A2..A0 open (PCF8574A: 0x3F)
+#define LCD_PCF8574_DEFAULT_ADDRESS			0x27
+
+// Port writes of one byte over the backpack: E high and E low for each nibble
+#define LCD_PCF8574_FRAME_SIZE				4
+
+// Address counter value when the DDRAM address is not known (no set-DDRAM command has bit 7 clear)
+#define LCD_ADDRESS_UNKNOWN					0x00
+
+// Deepest nesting of LCD_beginFrame calls
+#define LCD_FRAME_DEPTH_MAX					0xFF
+
+// Queue ticks per millisecond
+#define LCD_QUEUE_TICKS_PER_MS				((uint16_t)(DELAY_US_PER_MS / LCD_QUEUE_TICK_US))
+
+// Longest marquee step period in milliseconds
+#define LCD_MARQUEE_STEP_MS_MAX				(0xFFFFU / LCD_QUEUE_TICKS_PER_MS)
+
+// Characters of a marquee message; a line of DDRAM, of which LCD_COLS_MAX are visible at a time
+#define LCD_MARQUEE_TEXT_MAX				LCD_DDRAM_LINE_LENGTH
+
+// Shift steps of one full marquee pass, after which the display is back at its start position
+#define LCD_MARQUEE_PASS_STEPS				LCD_DDRAM_LINE_LENGTH
+
+// Marquee step count that scrolls until LCD_marqueeStop
+#define LCD_MARQUEE_ENDLESS					0
+
 // Enumeration for LCD operating modes
 typedef enum {
     LCD_4_BIT_MODE,
@@ -35,6 +183,24 @@ typedef enum {
     LCD_INVALID_MODE
 } lcd_enu_mode_t;
 
+// Enumeration for the way transfers wait for the controller
+typedef enum {
+	LCD_SYNC_DELAY = 0,     // Fixed worst-case delay after every transfer
+	LCD_SYNC_BUSY_FLAG      // Poll the busy flag through the RW pin
+} lcd_enu_sync_t;
+
+// Enumeration for the way LCD_cmd and LCD_char hand bytes to the controller
+typedef enum {
+	LCD_TRANSFER_BLOCKING = 0,  // Return after the controller has taken the byte
+	LCD_TRANSFER_ASYNC          // Queue the byte, a timer interrupt sends it
+} lcd_enu_transfer_t;
+
+// Enumeration for the link between the MCU and the controller
+typedef enum {
+	LCD_BUS_PARALLEL = 0,   // RS, RW, E and the data lines on DIO pins
+	LCD_BUS_PCF8574         // PCF8574 I2C backpack, driven by the TWI master
+} lcd_enu_bus_t;
+
 // Enumeration for selecting LCD rows
 typedef enum {
 	LCD_ROW_1 = 0,
@@ -56,12 +222,18 @@ typedef struct {
 } lcd_str_unit_t;
 
 // Configuration structure for LCD
+// The driver serves one display: the shadow buffer, cursor, frame depth, glyph cache and transmit queue are
+// kept once in the driver, not in this structure, and LCD_init() of a second display resets them.
 typedef struct {
 	lcd_enu_mode_t enu_mode;           // LCD mode (4-bit or 8-bit)
-	lcd_str_unit_t str_data_pins[LCD_MAX_DATA_PINS]; // Data pins
+	lcd_str_unit_t str_data_pins[LCD_MAX_DATA_PINS]; // Data pins, lowest first: D0..D7 in 8-bit mode, D4..D7 in 4-bit mode
 	lcd_str_unit_t str_RSpin;           // RS pin
 	lcd_str_unit_t str_RWpin;           // RW pin
 	lcd_str_unit_t str_Epin;            // E pin
+	lcd_enu_sync_t enu_sync;            // Transfer pacing (fixed delay or busy flag)
+	lcd_enu_transfer_t enu_transfer;    // Blocking or queued transfers
+	lcd_enu_bus_t enu_bus;              // Parallel pins or I2C backpack
+	uint8_t u8_i2c_address;             // 7-bit backpack address, LCD_BUS_PCF8574 only
 } lcd_str_config_t;
 
 // Enumeration for LCD return states
@@ -75,24 +247,54 @@ typedef enum {
 typedef uint8_t u8_en_lcdSpCharType;
 
 // Predefined special character value for a bell symbol
-#define LCD_BELL					((u8_en_lcdSpCharType)0X03)
+#define LCD_BELL					((u8_en_lcdSpCharType)0X00)
 
+// Number of predefined special characters
+#define LCD_SP_CHAR_COUNT			1
+
+// Bitmap of a user-defined 5x8 character, one row per byte, bit 4 is the leftmost pixel
+typedef struct {
+	uint8_t u8_arr_rows[LCD_GLYPH_ROWS];
+} lcd_str_glyph_t;
 
 
+// Horizontal bargraph drawn with partial-block glyphs
+typedef struct {
+	uint8_t u8_row;			// Row of the bar
+	uint8_t u8_col;			// First column of the bar
+	uint8_t u8_cells;		// Width of the bar in cells
+	uint8_t u8_level;		// Filled sub-steps, 0 .. u8_cells * LCD_BAR_STEPS_PER_CELL
+} lcd_str_bargraph_t;
+
 /**
  * @brief Initialize the LCD.
  *
- * This function initializes the LCD based on the provided configuration.
+ * This function configures the pins and queues the power-up sequence: the 40 ms supply wait, the three wake-up
+ * instructions of the reset handshake, the switch to 4 bits when needed, then function set, display on,
+ * entry mode and clear. The sequence is stepped by the queue tick, so the function returns at once and the
+ * rest of the system can be initialized while the controller powers up. Writes made before the sequence
+ * completes are queued behind it in the asynchronous transfer mode, and wait for it in the blocking mode.
+ *
+ * With enu_bus set to LCD_BUS_PCF8574 the pins are not used: the function initializes the TWI master and every
+ * byte is sent to the backpack at u8_i2c_address as one I2C transaction carrying both nibbles and their enable
+ * pulses. The backpack only wires 4 data lines and cannot be read back quickly, so it needs LCD_4_BIT_MODE and
+ * always paces transfers with the datasheet timing, whatever enu_sync says.
+ *
+ * Only one display is supported. Every later call must pass the configuration given here; the state of the
+ * display lives in the driver, so the other functions use their configuration argument only for the pins.
  *
  * @param[in] ptr_str_config Pointer to the LCD configuration structure.
- * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if initialization failed.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if initialization failed or the bus settings are invalid.
  */
 lcd_enu_return_state_t LCD_init (lcd_str_config_t *ptr_str_config);
 
 /**
  * @brief Send a command to the LCD.
  *
- * This function sends a command to the LCD screen.
+ * This function sends a command to the LCD screen. With the asynchronous transfer mode the command is queued
+ * and the function returns immediately. A full queue is waited on while interrupts are enabled; with interrupts
+ * disabled the tick cannot drain it and the command is refused instead. A blocking transfer waits for the
+ * power-up sequence the same way and is refused while it runs with interrupts disabled.
  *
  * @param[in] ptr_str_config Pointer to the LCD configuration structure.
  * @param[in] cmd The command to be sent.
@@ -103,18 +305,21 @@ lcd_enu_return_state_t LCD_cmd(lcd_str_config_t *ptr_str_config, uint8_t copy_u8
 /**
  * @brief Write a character to the LCD.
  *
- * This function writes a character to the LCD screen.
+ * This function writes a character to the LCD screen. With the asynchronous transfer mode the character is
+ * queued and the function returns immediately. With interrupts disabled a full queue, or in the blocking mode
+ * an unfinished power-up sequence, refuses the character like LCD_cmd().
  *
  * @param[in] ptr_str_config Pointer to the LCD configuration structure.
  * @param[in] cmd The character to be written.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the character was not sent or queued.
  */
-void LCD_char(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_data);
+lcd_enu_return_state_t LCD_char(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_data);
 
 
 /**
  * @brief Clear the LCD screen.
  *
- * This function clears the LCD screen by sending the appropriate command.
+ * This function blanks every cell of the shadow buffer. The panel is updated on the next LCD_refresh().
  *
  * @param[in] ptr_str_config Pointer to the LCD configuration structure.
  * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if clearing failed.
@@ -124,7 +329,7 @@ lcd_enu_return_state_t LCD_clear (lcd_str_config_t* ptr_str_config);
 /**
  * @brief Set the cursor position on the LCD.
  *
- * This function sets the cursor position on the LCD screen.
+ * This function sets the position of the next shadow buffer write.
  *
  * @param[in] ptr_str_config Pointer to the LCD configuration structure.
  * @param[in] copy_enu_row Selected row for the cursor.
@@ -136,7 +341,8 @@ lcd_enu_return_state_t LCD_setCursor (lcd_str_config_t *ptr_str_config, lcd_enu_
 /**
  * @brief Write a string to the LCD.
  *
- * This function writes a null-terminated string to the LCD.
+ * This function writes a null-terminated string to the shadow buffer at the cursor position.
+ * Characters past the last column are dropped. The panel is updated on the next LCD_refresh().
  *
  * @param[in] ptr_str_config Pointer to the LCD configuration structure.
  * @param[in] ptr_u8_data Pointer to the string data to be written.
@@ -144,10 +350,64 @@ lcd_enu_return_state_t LCD_setCursor (lcd_str_config_t *ptr_str_config, lcd_enu_
  */
 lcd_enu_return_state_t LCD_writeString (lcd_str_config_t *ptr_str_config, uint8_t *ptr_u8_data);
 
+/**
+ * @brief Write a string stored in program memory to the LCD.
+ *
+ * This function works like LCD_writeString() but reads the characters from flash, so the string does not need
+ * a copy in SRAM.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] ptr_u8_data Flash address of the null-terminated string, declared PROGMEM.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_writeString_P (lcd_str_config_t *ptr_str_config, const uint8_t *ptr_u8_data);
+
+/**
+ * @brief Write a string stored in program memory at a given position.
+ *
+ * This function moves the cursor and then writes the string with LCD_writeString_P().
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] copy_enu_row Row of the first character.
+ * @param[in] copy_enu_col Column of the first character.
+ * @param[in] ptr_u8_data Flash address of the null-terminated string, declared PROGMEM.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the position is invalid, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_writeStringAt_P (lcd_str_config_t *ptr_str_config, lcd_enu_row_select_t copy_enu_row, lcd_enu_col_select_t copy_enu_col, const uint8_t *ptr_u8_data);
+
+/**
+ * @brief Write a signed integer to the LCD.
+ *
+ * This function formats the value right-aligned in a field of copy_u8_width characters, padded with blanks, and
+ * writes it to the shadow buffer at the cursor position.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] copy_s16_value Value to write.
+ * @param[in] copy_u8_width Minimum field width, at most FORMAT_MAX_WIDTH.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the width is too large, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_writeNumber (lcd_str_config_t *ptr_str_config, sint16_t copy_s16_value, uint8_t copy_u8_width);
+
+/**
+ * @brief Write a Q-format fixed-point value to the LCD.
+ *
+ * This function formats copy_s16_value / 2^copy_u8_frac_bits with copy_u8_decimals rounded decimals, right-aligned
+ * in a field of copy_u8_width characters, and writes it to the shadow buffer at the cursor position.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] copy_s16_value Raw fixed-point value.
+ * @param[in] copy_u8_frac_bits Number of fractional bits.
+ * @param[in] copy_u8_decimals Digits after the decimal point.
+ * @param[in] copy_u8_width Minimum field width including sign and point.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if an argument is out of range, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_writeFixed (lcd_str_config_t *ptr_str_config, sint16_t copy_s16_value, uint8_t copy_u8_frac_bits, uint8_t copy_u8_decimals, uint8_t copy_u8_width);
+
 /**
  * @brief Write a special character to the LCD.
  *
- * This function writes a special character to the LCD screen.
+ * This function loads the special character bitmap through the glyph cache and places it in the first cell of the
+ * second row of the shadow buffer.
  *
  * @param[in] ptr_str_config Pointer to the LCD configuration structure.
  * @param[in] u8_SpChar The type of special character to be written.
@@ -155,5 +415,161 @@ lcd_enu_return_state_t LCD_writeString (lcd_str_config_t *ptr_str_config, uint8_
  */
 lcd_enu_return_state_t LCD_writeSpChar (lcd_str_config_t *ptr_str_config, u8_en_lcdSpCharType copy_u8_SpChar);
 
+/**
+ * @brief Get the character code of a glyph, loading it into CGRAM if it is not resident.
+ *
+ * Glyphs are identified by address, so they must live in static storage. A resident glyph costs no LCD
+ * transfer. Otherwise it is uploaded to a free slot or, when all 8 slots are taken, to the least recently
+ * used one; cells still showing the evicted glyph then show the new bitmap.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] ptr_str_glyph Pointer to the glyph bitmap.
+ * @param[out] ptr_u8_code Character code to write to DDRAM, LCD_CGRAM_CODE_BASE + slot.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if a full queue refused the upload, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_glyphAcquire (lcd_str_config_t *ptr_str_config, const lcd_str_glyph_t *ptr_str_glyph, uint8_t *ptr_u8_code);
+
+/**
+ * @brief Write a glyph to the LCD.
+ *
+ * This function acquires the glyph with LCD_glyphAcquire() and writes its code to the shadow buffer at the
+ * cursor position.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] ptr_str_glyph Pointer to the glyph bitmap.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_writeGlyph (lcd_str_config_t *ptr_str_config, const lcd_str_glyph_t *ptr_str_glyph);
+
+/**
+ * @brief Place an empty bargraph on the LCD.
+ *
+ * This function records the position of the bar and blanks its cells in the shadow buffer.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[out] ptr_str_bar Pointer to the bargraph to initialize.
+ * @param[in] copy_enu_row Row of the bar.
+ * @param[in] copy_enu_col First column of the bar.
+ * @param[in] copy_u8_cells Width of the bar in cells.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the bar does not fit, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_bargraphInit (lcd_str_config_t *ptr_str_config, lcd_str_bargraph_t *ptr_str_bar, lcd_enu_row_select_t copy_enu_row, lcd_enu_col_select_t copy_enu_col, uint8_t copy_u8_cells);
+
+/**
+ * @brief Set the fill level of a bargraph.
+ *
+ * Each cell shows 0 to LCD_BAR_STEPS_PER_CELL filled pixel columns. Only the cells between the old and the new
+ * level are rewritten, so a one-step change touches one or two cells.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in,out] ptr_str_bar Pointer to the bargraph.
+ * @param[in] copy_u8_level New level in sub-steps.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the level exceeds the bar (the bar is filled), LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_bargraphSet (lcd_str_config_t *ptr_str_config, lcd_str_bargraph_t *ptr_str_bar, uint8_t copy_u8_level);
+
+/**
+ * @brief Send the changed cells of the shadow buffer to the LCD.
+ *
+ * This function walks the dirty cells of each row and sends them in runs,
+ * issuing one set-address command per run. Short gaps of unchanged cells inside a run are rewritten
+ * rather than skipped with another set-address command. The controller's address counter is tracked, so a
+ * run that starts where the last write left it, or just after, needs no set-address command at all.
+ * Inside a frame opened with LCD_beginFrame() the refresh is deferred to the closing LCD_endFrame(), and
+ * while a marquee runs it is deferred to the first refresh after the marquee ends.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if a full queue refused a transfer with interrupts disabled (the cells not sent stay dirty), LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_refresh (lcd_str_config_t *ptr_str_config);
+
+/**
+ * @brief Scroll a message through a row with the controller's display shift.
+ *
+ * This function loads the message into the 40 DDRAM cells of the row once, then the queue tick sends one
+ * LCD_DISPLAY_SHIFT_LEFT instruction every copy_u16_step_ms, so scrolling costs one transfer per step and the
+ * caller keeps running. The shift moves the whole display, so the other row scrolls along with it. While the
+ * marquee runs, LCD_refresh() is deferred; the shadow buffer can still be written and is sent once the marquee
+ * ends with a return home that puts the display back at its start position. Only the asynchronous transfer
+ * mode runs a marquee.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] copy_enu_row Row of the message.
+ * @param[in] ptr_u8_text Flash address of the null-terminated message, declared PROGMEM, at most LCD_MARQUEE_TEXT_MAX characters are shown.
+ * @param[in] copy_u16_step_ms Time between two shift steps, 1 .. LCD_MARQUEE_STEP_MS_MAX.
+ * @param[in] copy_u8_steps Shift steps before the marquee ends by itself, LCD_MARQUEE_PASS_STEPS for one full pass, LCD_MARQUEE_ENDLESS to run until LCD_marqueeStop().
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if an argument is invalid, a marquee is already running, transfers are blocking or a full queue refused the message, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_marqueeStart (lcd_str_config_t *ptr_str_config, lcd_enu_row_select_t copy_enu_row, const uint8_t *ptr_u8_text, uint16_t copy_u16_step_ms, uint8_t copy_u8_steps);
+
+/**
+ * @brief End the running marquee.
+ *
+ * The queue tick returns the display to its start position on its next tick, the function does not wait for it;
+ * LCD_marqueeIsActive() reports FALSE once it has.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_marqueeStop (lcd_str_config_t *ptr_str_config);
+
+/**
+ * @brief Check whether a marquee is running.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[out] ptr_u8_active TRUE until the display is back at its start position, FALSE otherwise.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_marqueeIsActive (lcd_str_config_t *ptr_str_config, uint8_t *ptr_u8_active);
+
+/**
+ * @brief Open a frame.
+ *
+ * Until the matching LCD_endFrame(), LCD_refresh() sends nothing, so any number of setCursor and write calls,
+ * including helpers that refresh on their own, are merged into one pass over the dirty cells. Frames nest.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if frames are nested too deep, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_beginFrame (lcd_str_config_t *ptr_str_config);
+
+/**
+ * @brief Close a frame.
+ *
+ * Closing the outermost frame sends every cell changed since LCD_beginFrame() with LCD_refresh().
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if no frame is open, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_endFrame (lcd_str_config_t *ptr_str_config);
+
+/**
+ * @brief Wait until every queued transfer has reached the controller.
+ *
+ * This function returns immediately with the blocking transfer mode.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_flush (lcd_str_config_t *ptr_str_config);
+
+/**
+ * @brief Check whether the power-up sequence has completed.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[out] ptr_u8_ready TRUE once the controller is initialized, FALSE while the sequence is running.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_isReady (lcd_str_config_t *ptr_str_config, uint8_t *ptr_u8_ready);
+
+/**
+ * @brief Check whether the transmit queue is drained.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[out] ptr_u8_idle TRUE if no transfer is queued or in progress, FALSE otherwise.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_isIdle (lcd_str_config_t *ptr_str_config, uint8_t *ptr_u8_idle);
+
 
 #endif /* LCD_INTERFACE_H	*/
\ No newline at end of file
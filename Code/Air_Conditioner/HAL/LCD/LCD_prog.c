@@ -9,6 +9,158 @@
  */
 
 #include "LCD_interface.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
+
+/**
+ * @brief Shadow copy of the display contents.
+ *
+ * The driver state below belongs to the single display set up by LCD_init(). Every cell holds the character the panel shows once the dirty cells have been sent by LCD_refresh().
+ */
+static uint8_t gs_u8_arr_shadow[LCD_ROWS_MAX][LCD_COLS_MAX];
+
+/**
+ * @brief Dirty cell masks, one bit per column of each row.
+ */
+static uint16_t gs_u16_arr_dirty[LCD_ROWS_MAX];
+
+/**
+ * @brief Shadow buffer cursor.
+ */
+static uint8_t gs_u8_cursorRow;
+static uint8_t gs_u8_cursorCol;
+
+/**
+ * @brief DDRAM start address of each row.
+ */
+static const uint8_t gs_u8_arr_rowAddress[LCD_ROWS_MAX] = {LCD_DDRAM_START_ADD_LINE_1, LCD_DDRAM_START_ADD_LINE_2};
+
+/**
+ * @brief Glyph resident in each CGRAM slot, NULL when the slot is free.
+ */
+static const lcd_str_glyph_t *gs_ptr_str_arr_slotGlyph[LCD_CGRAM_SLOTS];
+
+/**
+ * @brief CGRAM slots ordered from most to least recently used.
+ */
+static uint8_t gs_u8_arr_slotOrder[LCD_CGRAM_SLOTS];
+
+/**
+ * @brief Bitmaps of the predefined special characters, indexed by u8_en_lcdSpCharType.
+ */
+static const lcd_str_glyph_t gs_str_arr_spChar[LCD_SP_CHAR_COUNT] = {
+	{{0x04, 0x0E, 0x0E, 0x0E, 0x1F, 0x00, 0x04, 0x00}}		// LCD_BELL
+};
+
+/**
+ * @brief Partial-block glyphs of the bargraph, 1 to LCD_BAR_STEPS_PER_CELL - 1 pixel columns filled from the left.
+ */
+static const lcd_str_glyph_t gs_str_arr_barGlyph[LCD_BAR_STEPS_PER_CELL - 1] = {
+	{{0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10}},
+	{{0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18}},
+	{{0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C}},
+	{{0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E}}
+};
+
+/**
+ * @brief TRUE once the controller is initialized and transfers are paced by its busy flag.
+ */
+static uint8_t gs_u8_busyFlagActive = FALSE;
+
+/**
+ * @brief TRUE when the data pins are contiguous on one port and are written with a single masked port write.
+ */
+static uint8_t gs_u8_dataPortWrite = FALSE;
+
+/**
+ * @brief Port, mask and lowest pin of the data lines for the single-write path.
+ */
+static dio_enu_port_t gs_enu_dataPort;
+static uint8_t gs_u8_dataMask;
+static uint8_t gs_u8_dataShift;
+
+/**
+ * @brief Transmit queue, drained by the tick interrupt in the asynchronous transfer mode.
+ */
+static volatile uint16_t gs_u16_arr_queue[LCD_QUEUE_SIZE];
+static volatile uint8_t gs_u8_queueHead = U8_ZERO_VALUE;
+static volatile uint8_t gs_u8_queueTail = U8_ZERO_VALUE;
+
+/**
+ * @brief TRUE while the tick timer runs, the tick stops it once there is nothing left to send.
+ */
+static volatile uint8_t gs_u8_queueTickRunning = FALSE;
+
+/**
+ * @brief DDRAM address the controller writes next, in set-DDRAM command form, or LCD_ADDRESS_UNKNOWN.
+ *
+ * Updated in program order by LCD_cmd() and LCD_char(), which is the order the controller sees the transfers.
+ */
+static uint8_t gs_u8_addressCounter = LCD_ADDRESS_UNKNOWN;
+
+/**
+ * @brief TRUE while the entry mode increments the address counter.
+ */
+static uint8_t gs_u8_addressIncrement = FALSE;
+
+/**
+ * @brief Number of open frames, LCD_refresh() is deferred while it is not zero.
+ */
+static uint8_t gs_u8_frameDepth = U8_ZERO_VALUE;
+
+/**
+ * @brief TRUE from LCD_marqueeStart() until the tick has returned the display to its start position.
+ */
+static volatile uint8_t gs_u8_marqueeActive = FALSE;
+
+/**
+ * @brief Set by LCD_marqueeStop() to end the marquee on the next tick.
+ */
+static volatile uint8_t gs_u8_marqueeStop = FALSE;
+
+/**
+ * @brief Set by the tick after the last shift step.
+ */
+static volatile uint8_t gs_u8_marqueeDone = FALSE;
+
+/**
+ * @brief Shift steps left, LCD_MARQUEE_ENDLESS when the marquee runs until stopped.
+ */
+static volatile uint8_t gs_u8_marqueeStepsLeft;
+
+/**
+ * @brief Queue ticks between two shift steps.
+ */
+static volatile uint16_t gs_u16_marqueePeriod;
+
+/**
+ * @brief Queue ticks left before the next shift step.
+ */
+static volatile uint16_t gs_u16_marqueeCountdown;
+
+/**
+ * @brief TRUE once the power-up sequence has completed.
+ */
+static volatile uint8_t gs_u8_ready = FALSE;
+
+/**
+ * @brief Ticks left before the controller finishes the last long instruction or queued wait.
+ */
+static volatile uint8_t gs_u8_queueWaitTicks = U8_ZERO_VALUE;
+
+/**
+ * @brief Display served by the tick interrupt, NULL while transfers are blocking.
+ */
+static lcd_str_config_t * volatile gs_ptr_str_queueConfig = NULL;
+
+/**
+ * @brief Port writes of the backpack transaction in flight, read by the TWI interrupt.
+ */
+static uint8_t gs_u8_arr_busFrame[LCD_PCF8574_FRAME_SIZE];
+
+/**
+ * @brief Timer configuration of the transmit queue tick.
+ */
+static timerm_str_config_t gs_str_queueTimerConfig;
 
 
 /**
@@ -21,16 +173,203 @@
 static void ENABLE(lcd_str_config_t* ptr_str_config);
 
 /**
- * @brief Delay function for approximately 3 milliseconds.
+ * @brief Send one byte to the instruction or data register.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] copy_u8_data Byte to send.
+ * @param[in] copy_enu_rs_level RS level: low for the instruction register, high for the data register.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the mode is invalid.
+ */
+static lcd_enu_return_state_t LCD_sendByte(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_data, dio_enu_level_t copy_enu_rs_level);
+
+/**
+ * @brief Drive one byte onto the bus without waiting for the controller.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] copy_u8_data Byte to send.
+ * @param[in] copy_enu_rs_level RS level: low for the instruction register, high for the data register.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the mode is invalid.
+ */
+static lcd_enu_return_state_t LCD_transferByte(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_data, dio_enu_level_t copy_enu_rs_level);
+
+/**
+ * @brief Send a wake-up instruction of the reset handshake.
+ *
+ * In 4-bit mode only the high nibble is latched, because the controller still expects an 8-bit interface.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] copy_u8_cmd Wake-up instruction.
+ */
+static void LCD_transferWakeUp(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_cmd);
+
+/**
+ * @brief Send a byte or a single high nibble to the PCF8574 backpack in one I2C transaction.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] copy_u8_data Byte to send.
+ * @param[in] copy_enu_rs_level RS level: low for the instruction register, high for the data register.
+ * @param[in] copy_u8_nibbles 2 for a whole byte, 1 for the high nibble only.
+ */
+static void LCD_busFrame(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_data, dio_enu_level_t copy_enu_rs_level, uint8_t copy_u8_nibbles);
+
+/**
+ * @brief Check whether a backpack transaction is still on the bus.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @return TRUE while the TWI master is sending, FALSE when it is idle or the parallel bus is used.
+ */
+static uint8_t LCD_busInFlight(lcd_str_config_t *ptr_str_config);
+
+/**
+ * @brief Put the low 4 bits of a value on the data pins and latch them.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] copy_u8_nibble Value whose low nibble is sent.
+ */
+static void LCD_writeNibble(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_nibble);
+
+/**
+ * @brief Wait until the controller can accept the next transfer.
+ *
+ * In busy flag mode the data pins are switched to input and BF is polled until it clears. If it does not
+ * clear within LCD_BUSY_FLAG_POLL_MAX reads, or the busy flag is not in use, the execution time of the
+ * byte just sent is waited instead.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] copy_u8_data Byte just sent.
+ * @param[in] copy_enu_rs_level RS level the byte was sent with.
+ */
+static void LCD_waitReady(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_data, dio_enu_level_t copy_enu_rs_level);
+
+/**
+ * @brief Wait the datasheet execution time of one byte.
+ *
+ * @param[in] copy_u8_data Byte just sent.
+ * @param[in] copy_enu_rs_level RS level the byte was sent with.
+ */
+static void LCD_waitExecTime(uint8_t copy_u8_data, dio_enu_level_t copy_enu_rs_level);
+
+/**
+ * @brief Check whether the data pins allow the single-write path and record its port, mask and shift.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] copy_u8_data_pins Number of data pins used by the mode.
+ */
+static void LCD_detectDataPort(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_data_pins);
+
+/**
+ * @brief Read the busy flag once.
+ *
+ * The data pins are switched to input for the read and back to output afterwards.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @return DIO_PIN_HIGH_LEVEL while the controller is busy, DIO_PIN_LOW_LEVEL when it is ready.
+ */
+static dio_enu_level_t LCD_readBusyFlag(lcd_str_config_t *ptr_str_config);
+
+/**
+ * @brief Append an entry to the transmit queue.
+ *
+ * A full queue is waited on while interrupts are enabled, the tick frees an entry within one period. With
+ * interrupts disabled, inside a callback or before sei(), nothing can free an entry and the entry is refused.
+ *
+ * @param[in] copy_u16_entry Byte to send, with LCD_QUEUE_DATA_FLAG set for the data register.
+ * @return Operation status: LCD_E_OK if queued, LCD_E_NOT_OK if the queue is full and interrupts are disabled.
+ */
+static lcd_enu_return_state_t LCD_enqueue(uint16_t copy_u16_entry);
+
+/**
+ * @brief Queue a wait of any length, split into entries of at most LCD_QUEUE_WAIT_MAX ticks.
+ *
+ * @param[in] copy_u16_ticks Wait in queue ticks.
+ * @return Operation status: LCD_E_OK if queued, LCD_E_NOT_OK if the queue is full and interrupts are disabled.
+ */
+static lcd_enu_return_state_t LCD_enqueueWait(uint16_t copy_u16_ticks);
+
+/**
+ * @brief Restart the tick timer if the tick has stopped it, without changing the interrupt enable state.
+ */
+static void LCD_queueTickStart(void);
+
+/**
+ * @brief Timer callback that processes the oldest queued entry once the controller is ready.
+ *
+ * Besides bytes for the instruction and data registers, an entry can be a single wake-up nibble, a wait,
+ * or the end-of-power-up marker that enables the busy flag and, in the blocking mode, stops the tick.
+ * The tick also stops itself once the queue is empty, no wait is pending and no marquee runs.
+ */
+static void LCD_queueTick(void);
+
+/**
+ * @brief Wait until the power-up sequence is done before a blocking transfer.
+ *
+ * The sequence is sent by the tick interrupt. With interrupts disabled it cannot finish, so an unfinished
+ * sequence is reported instead of waited on.
+ *
+ * @return Operation status: LCD_E_OK once the sequence is done, LCD_E_NOT_OK if it is still running and
+ *         interrupts are disabled.
+ */
+static lcd_enu_return_state_t LCD_waitPowerUp(void);
+
+/**
+ * @brief Store a character in the shadow buffer.
+ *
+ * The cell is marked dirty only if its content changes.
+ *
+ * @param[in] copy_u8_row Row of the cell.
+ * @param[in] copy_u8_col Column of the cell.
+ * @param[in] copy_u8_data Character to store.
+ */
+static void LCD_shadowPut(uint8_t copy_u8_row, uint8_t copy_u8_col, uint8_t copy_u8_data);
+
+/**
+ * @brief Find the next dirty cell of a row.
+ *
+ * @param[in] copy_u8_row Row to search.
+ * @param[in] copy_u8_col First column to check.
+ * @return Column of the next dirty cell, or LCD_COLS_MAX if there is none.
+ */
+static uint8_t LCD_nextDirty(uint8_t copy_u8_row, uint8_t copy_u8_col);
+
+/**
+ * @brief Step the running marquee, called by the queue tick once the queue is empty.
+ */
+static void LCD_marqueeTick(void);
+
+/**
+ * @brief Update the tracked address counter for a command sent to the controller.
+ *
+ * @param[in] copy_u8_cmd Instruction byte.
+ */
+static void LCD_trackCommand(uint8_t copy_u8_cmd);
+
+/**
+ * @brief Update the tracked address counter for a data byte sent to the controller.
+ */
+static void LCD_trackData(void);
+
+/**
+ * @brief Column of a row the address counter points at.
+ *
+ * @param[in] copy_u8_row Row to check.
+ * @return Column of the address counter, or LCD_COLS_MAX if it is unknown, on the other row or off screen.
+ */
+static uint8_t LCD_addressColumn(uint8_t copy_u8_row);
+
+/**
+ * @brief Draw one cell of a bargraph from its current level.
  *
- * This function implements a delay loop to approximate a delay of 3 milliseconds.
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] ptr_str_bar Pointer to the bargraph.
+ * @param[in] copy_u8_cell Index of the cell inside the bar.
  */
-static void delay_3_ms(void);
+static void LCD_bargraphDrawCell(lcd_str_config_t *ptr_str_config, lcd_str_bargraph_t *ptr_str_bar, uint8_t copy_u8_cell);
 
 /**
  * @brief Initialize the LCD.
  *
- * This function initializes the LCD based on the provided configuration.
+ * This function configures the pins, resets the driver state and queues the power-up sequence. The queue
+ * tick is started in both transfer modes; in the blocking mode it stops itself once the sequence is done.
  *
  * @param[in] ptr_str_config Pointer to the LCD configuration structure.
  * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if initialization failed.
@@ -38,35 +377,114 @@ static void delay_3_ms(void);
 lcd_enu_return_state_t LCD_init(lcd_str_config_t* ptr_str_config)
 {
 	lcd_enu_return_state_t enu_return_state = LCD_E_OK;
+	uint8_t u8_data_pins = LCD_MAX_DATA_PINS_MOD_4;
 	
-	enu_return_state |=DIO_init(ptr_str_config->str_RSpin.enu_port, ptr_str_config->str_RSpin.enu_pin, DIO_PIN_OUTPUT);
-	enu_return_state |=DIO_init(ptr_str_config->str_RWpin.enu_port, ptr_str_config->str_RWpin.enu_pin, DIO_PIN_OUTPUT);
-	enu_return_state |=DIO_init(ptr_str_config->str_Epin.enu_port, ptr_str_config->str_Epin.enu_pin, DIO_PIN_OUTPUT);
+	/* BF is not valid until the function set has been accepted, so the power-up sequence runs on fixed waits */
+	gs_u8_busyFlagActive = FALSE;
+	gs_u8_ready = FALSE;
+	gs_ptr_str_queueConfig = NULL;
 	
-	if(ptr_str_config->enu_mode == LCD_4_BIT_MODE)
+	if(ptr_str_config == NULL)
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else if((ptr_str_config->enu_mode != LCD_4_BIT_MODE) && (ptr_str_config->enu_mode != LCD_8_BIT_MODE))
+	{
+		enu_return_state = LCD_E_NOT_OK;
+	}
+	else if(ptr_str_config->enu_bus == LCD_BUS_PCF8574)
+	{
+		if((ptr_str_config->enu_mode != LCD_4_BIT_MODE) || (ptr_str_config->u8_i2c_address > TWI_ADDRESS_MAX))
+		{
+			enu_return_state = LCD_E_NOT_OK;
+		}
+		else
+		{
+			TWI_init();
+		}
+	}
+	else
+	{
+		if(ptr_str_config->enu_mode == LCD_8_BIT_MODE)
+		{
+			u8_data_pins = LCD_MAX_DATA_PINS_MOD_8;
+		}
+		enu_return_state |=DIO_init(ptr_str_config->str_RSpin.enu_port, ptr_str_config->str_RSpin.enu_pin, DIO_PIN_OUTPUT);
+		enu_return_state |=DIO_init(ptr_str_config->str_RWpin.enu_port, ptr_str_config->str_RWpin.enu_pin, DIO_PIN_OUTPUT);
+		enu_return_state |=DIO_init(ptr_str_config->str_Epin.enu_port, ptr_str_config->str_Epin.enu_pin, DIO_PIN_OUTPUT);
+		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < u8_data_pins; u8_counter++){
+			enu_return_state |=DIO_init(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin, DIO_PIN_OUTPUT);
+		}
+		LCD_detectDataPort(ptr_str_config, u8_data_pins);
+	}
+	
+	/* The clear command leaves every DDRAM cell blank, so the shadow buffer starts clean */
+	for(uint8_t u8_row = U8_ZERO_VALUE; u8_row < LCD_ROWS_MAX; u8_row++){
+		for(uint8_t u8_col = U8_ZERO_VALUE; u8_col < LCD_COLS_MAX; u8_col++){
+			gs_u8_arr_shadow[u8_row][u8_col] = LCD_BLANK_CHAR;
+		}
+		gs_u16_arr_dirty[u8_row] = U8_ZERO_VALUE;
+	}
+	gs_u8_cursorRow = LCD_ROW_1;
+	gs_u8_cursorCol = LCD_COL_1;
+	gs_u8_frameDepth = U8_ZERO_VALUE;
+	gs_u8_marqueeActive = FALSE;
+	
+	/* CGRAM content is undefined after power-up, every slot starts free */
+	for(uint8_t u8_slot = U8_ZERO_VALUE; u8_slot < LCD_CGRAM_SLOTS; u8_slot++){
+		gs_ptr_str_arr_slotGlyph[u8_slot] = NULL;
+		gs_u8_arr_slotOrder[u8_slot] = u8_slot;
+	}
+	
+	if(enu_return_state == LCD_E_OK)
 	{
+		gs_u8_queueHead = U8_ZERO_VALUE;
+		gs_u8_queueTail = U8_ZERO_VALUE;
+		gs_u8_queueWaitTicks = U8_ZERO_VALUE;
+		
+		/* power-up sequence, stepped by the queue tick; it fits the empty queue */
+		LCD_enqueueWait(LCD_QUEUE_TICKS(LCD_POWER_ON_DELAY_MS * DELAY_US_PER_MS));
+		LCD_enqueue(LCD_QUEUE_NIBBLE_FLAG | LCD_CMD_WAKE_UP);
+		LCD_enqueueWait(LCD_QUEUE_TICKS(LCD_WAKE_UP_FIRST_DELAY_US));
+		LCD_enqueue(LCD_QUEUE_NIBBLE_FLAG | LCD_CMD_WAKE_UP);
+		LCD_enqueueWait(LCD_QUEUE_TICKS(LCD_WAKE_UP_DELAY_US));
+		LCD_enqueue(LCD_QUEUE_NIBBLE_FLAG | LCD_CMD_WAKE_UP);
+		LCD_enqueueWait(LCD_QUEUE_TICKS(LCD_WAKE_UP_DELAY_US));
+		if(ptr_str_config->enu_mode == LCD_4_BIT_MODE)
+		{
+			LCD_enqueue(LCD_QUEUE_NIBBLE_FLAG | LCD_CMD_WAKE_UP_4_BIT);
+			LCD_enqueueWait(LCD_QUEUE_TICKS(LCD_WAKE_UP_DELAY_US));
+			LCD_enqueue(LCD_4BITS_2LINES_58DM);
+		}
+		else
+		{
+			LCD_enqueue(LCD_8BITS_2LINES_58DM);
+		}
+		LCD_enqueue(LCD_DISPLAY_ON_CUR_OFF_BLOCK_OFF);
+		LCD_enqueue(LCD_CMD_ENTRY_MODE_INCREMENT_ON_SHIFT_OFF);
+		LCD_enqueue(LCD_CMD_CLEAR);
+		LCD_enqueue(LCD_QUEUE_READY_FLAG);
 		
+		/* the clear leaves the address counter on the first cell, counting up */
+		gs_u8_addressCounter = LCD_DDRAM_START_ADD_LINE_1;
+		gs_u8_addressIncrement = TRUE;
 		
-		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < LCD_MAX_DATA_PINS_MOD_4; u8_counter++){
-			enu_return_state |=DIO_init(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin, DIO_PIN_OUTPUT);
+		gs_str_queueTimerConfig.enu_timer_no = LCD_QUEUE_TIMER;
+		gs_str_queueTimerConfig.enu_timer_mode = TIMER_CTC_MODE;
+		gs_str_queueTimerConfig.u16_timer_initial_value = INTIALIZE_TIMER_WITH_ZERO;
+		gs_str_queueTimerConfig.u16_timer_compare_match_value = LCD_QUEUE_TICK_COMPARE_VALUE;
+		gs_str_queueTimerConfig.ptr_call_back_func = LCD_queueTick;
+		gs_str_queueTimerConfig.enu_prescaller = LCD_QUEUE_TIMER_PRESCALER;
+		if(TIMER_MANGER_init(&gs_str_queueTimerConfig) == TIMERM_E_OK)
+		{
+			gs_ptr_str_queueConfig = ptr_str_config;
+			gs_u8_queueTickRunning = FALSE;
+			LCD_queueTickStart();
 		}
-		LCD_cmd(ptr_str_config, LCD_CMD_CURSOR_HOME);
-		LCD_cmd(ptr_str_config, LCD_4BITS_2LINES_58DM);
-		LCD_cmd(ptr_str_config, LCD_DISPLAY_ON_CUR_OFF_BLOCK_OFF);
-		LCD_cmd(ptr_str_config, LCD_CMD_ENTRY_MODE_INCREMENT_ON_SHIFT_OFF);
-		LCD_cmd(ptr_str_config, LCD_CMD_CLEAR);						
-								
-	}else if(ptr_str_config->enu_mode == LCD_8_BIT_MODE){
-		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < LCD_MAX_DATA_PINS_MOD_8; u8_counter++){
-			enu_return_state |=DIO_init(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin, DIO_PIN_OUTPUT);
+		else
+		{
+			enu_return_state = LCD_E_NOT_OK;
 		}
-		LCD_cmd(ptr_str_config, LCD_8BITS_2LINES_58DM);
-		LCD_cmd(ptr_str_config, LCD_DISPLAY_ON_CUR_OFF_BLOCK_OFF);
-		LCD_cmd(ptr_str_config, LCD_CMD_ENTRY_MODE_INCREMENT_ON_SHIFT_OFF);
-		LCD_cmd(ptr_str_config, LCD_CMD_CLEAR);
-							
-	}else{
-		enu_return_state=LCD_E_NOT_OK;						
 	}
 	return enu_return_state;
 }
@@ -74,25 +492,35 @@ lcd_enu_return_state_t LCD_init(lcd_str_config_t* ptr_str_config)
 /**
  * @brief Clear the LCD screen.
  *
- * This function clears the LCD screen by sending the appropriate command.
+ * This function blanks every cell of the shadow buffer. The panel is updated on the next LCD_refresh().
  *
  * @param[in] ptr_str_config Pointer to the LCD configuration structure.
  * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if clearing failed.
  */
-	lcd_enu_return_state_t LCD_clear (lcd_str_config_t* ptr_str_config)
+lcd_enu_return_state_t LCD_clear (lcd_str_config_t* ptr_str_config)
+{
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	if(ptr_str_config == NULL)
 	{
-
-		lcd_enu_return_state_t enu_return_state=LCD_E_OK;
-		enu_return_state |= LCD_cmd(ptr_str_config,LCD_CMD_CLEAR);
-		delay_3_ms();
-		return enu_return_state;
-
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else
+	{
+		for(uint8_t u8_row = U8_ZERO_VALUE; u8_row < LCD_ROWS_MAX; u8_row++){
+			for(uint8_t u8_col = U8_ZERO_VALUE; u8_col < LCD_COLS_MAX; u8_col++){
+				LCD_shadowPut(u8_row, u8_col, LCD_BLANK_CHAR);
+			}
+		}
+		gs_u8_cursorRow = LCD_ROW_1;
+		gs_u8_cursorCol = LCD_COL_1;
 	}
+	return enu_return_state;
+}
 
 /**
  * @brief Set the cursor position on the LCD.
  *
- * This function sets the cursor position on the LCD screen.
+ * This function sets the position of the next shadow buffer write.
  *
  * @param[in] ptr_str_config Pointer to the LCD configuration structure.
  * @param[in] copy_enu_row Selected row for the cursor.
@@ -102,13 +530,10 @@ lcd_enu_return_state_t LCD_init(lcd_str_config_t* ptr_str_config)
 lcd_enu_return_state_t LCD_setCursor (lcd_str_config_t* ptr_str_config, lcd_enu_row_select_t copy_enu_row, lcd_enu_col_select_t copy_enu_col)
 {
 	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
-	if(copy_enu_row == LCD_ROW_1)
+	if((copy_enu_row < LCD_ROWS_MAX) && (copy_enu_col < LCD_COLS_MAX))
 	{
-		LCD_cmd(ptr_str_config, LCD_DDRAM_START_ADD_LINE_1 + copy_enu_col);
-		
-	}else if(copy_enu_row == LCD_ROW_2){
-		LCD_cmd(ptr_str_config, LCD_DDRAM_START_ADD_LINE_2 + copy_enu_col);	
-
+		gs_u8_cursorRow = copy_enu_row;
+		gs_u8_cursorCol = copy_enu_col;
 	}else{
 		
 		enu_return_state=LCD_E_NOT_OK;
@@ -121,7 +546,8 @@ lcd_enu_return_state_t LCD_setCursor (lcd_str_config_t* ptr_str_config, lcd_enu_
 /**
  * @brief Write a string to the LCD.
  *
- * This function writes a null-terminated string to the LCD.
+ * This function writes a null-terminated string to the shadow buffer at the cursor position.
+ * Characters past the last column are dropped. The panel is updated on the next LCD_refresh().
  *
  * @param[in] ptr_str_config Pointer to the LCD configuration structure.
  * @param[in] ptr_u8_data Pointer to the string data to be written.
@@ -140,7 +566,11 @@ lcd_enu_return_state_t LCD_writeString (lcd_str_config_t *ptr_str_config, uint8_
 	{
 		while(ptr_u8_data[u8_char_counter] !='\0')
 		{
-			LCD_char(ptr_str_config,ptr_u8_data[u8_char_counter]);
+			if(gs_u8_cursorCol < LCD_COLS_MAX)
+			{
+				LCD_shadowPut(gs_u8_cursorRow, gs_u8_cursorCol, ptr_u8_data[u8_char_counter]);
+				gs_u8_cursorCol++;
+			}
 			u8_char_counter++;
 			
 		}
@@ -151,145 +581,1110 @@ lcd_enu_return_state_t LCD_writeString (lcd_str_config_t *ptr_str_config, uint8_
 }
 
 /**
- * @brief Write a special character to the LCD.
+ * @brief Write a string stored in program memory to the LCD.
  *
- * This function writes a special character to the LCD screen.
+ * This function works like LCD_writeString() but reads the characters from flash, so the string does not need
+ * a copy in SRAM.
  *
  * @param[in] ptr_str_config Pointer to the LCD configuration structure.
- * @param[in] u8_SpChar The type of special character to be written.
- * @return Operation status: LCD_E_OK if successful.
+ * @param[in] ptr_u8_data Flash address of the null-terminated string, declared PROGMEM.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
  */
-lcd_enu_return_state_t LCD_writeSpChar (lcd_str_config_t *ptr_str_config, u8_en_lcdSpCharType u8_SpChar)
-{   lcd_enu_return_state_t enu_return_state=LCD_E_OK;
-	uint8_t sp_char[]= {0x04, 0x0E, 0x0E, 0x0E, 0x1F, 0x00, 0x04, 0x00};
-	uint8_t i;
-	LCD_cmd(ptr_str_config,LCD_CGRAM_START_ADD+( u8_SpChar* LCD_1_BYTE));
-	for(i=U8_ZERO_VALUE;i<LCD_1_BYTE;i++)
+lcd_enu_return_state_t LCD_writeString_P (lcd_str_config_t *ptr_str_config, const uint8_t *ptr_u8_data)
+{
+	uint8_t u8_char;
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	if(ptr_u8_data == NULL)
 	{
-		LCD_char(ptr_str_config,sp_char[i]);
-	}	
-	
-	LCD_cmd(ptr_str_config,LCD_DDRAM_START_ADD_LINE_2);
-	LCD_char(ptr_str_config,LCD_BELL);
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else
+	{
+		u8_char = pgm_read_byte(ptr_u8_data);
+		while(u8_char != '\0')
+		{
+			if(gs_u8_cursorCol < LCD_COLS_MAX)
+			{
+				LCD_shadowPut(gs_u8_cursorRow, gs_u8_cursorCol, u8_char);
+				gs_u8_cursorCol++;
+			}
+			ptr_u8_data++;
+			u8_char = pgm_read_byte(ptr_u8_data);
+		}
+	}
 	return enu_return_state;
 }
 
 /**
- * @brief Send a command to the LCD.
+ * @brief Write a string stored in program memory at a given position.
  *
- * This function sends a command to the LCD screen.
+ * This function moves the cursor and then writes the string with LCD_writeString_P().
  *
  * @param[in] ptr_str_config Pointer to the LCD configuration structure.
- * @param[in] cmd The command to be sent.
- * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if sending the command failed.
+ * @param[in] copy_enu_row Row of the first character.
+ * @param[in] copy_enu_col Column of the first character.
+ * @param[in] ptr_u8_data Flash address of the null-terminated string, declared PROGMEM.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the position is invalid, LCD_NULL_PTR if NULL pointer provided.
  */
-lcd_enu_return_state_t LCD_cmd(lcd_str_config_t *ptr_str_config,uint8_t cmd)
-{   lcd_enu_return_state_t enu_return_state=LCD_E_OK;
-	lcd_enu_return_state_t u8_bit_counter = LCD_MSB_INDEX;
-	DIO_write_pin(ptr_str_config->str_Epin.enu_port,ptr_str_config->str_Epin.enu_pin,DIO_PIN_LOW_LEVEL);
-	DIO_write_pin(ptr_str_config->str_RSpin.enu_port,ptr_str_config->str_RSpin.enu_pin,DIO_PIN_LOW_LEVEL);
-	DIO_write_pin(ptr_str_config->str_RWpin.enu_port,ptr_str_config->str_RWpin.enu_pin,DIO_PIN_LOW_LEVEL);
-	if(ptr_str_config->enu_mode == LCD_4_BIT_MODE)
+lcd_enu_return_state_t LCD_writeStringAt_P (lcd_str_config_t *ptr_str_config, lcd_enu_row_select_t copy_enu_row, lcd_enu_col_select_t copy_enu_col, const uint8_t *ptr_u8_data)
+{
+	lcd_enu_return_state_t enu_return_state;
+	enu_return_state = LCD_setCursor(ptr_str_config, copy_enu_row, copy_enu_col);
+	if(enu_return_state == LCD_E_OK)
+	{
+		enu_return_state = LCD_writeString_P(ptr_str_config, ptr_u8_data);
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Write a signed integer to the LCD.
+ *
+ * This function formats the value right-aligned in a field of copy_u8_width characters, padded with blanks, and
+ * writes it to the shadow buffer at the cursor position.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] copy_s16_value Value to write.
+ * @param[in] copy_u8_width Minimum field width, at most FORMAT_MAX_WIDTH.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the width is too large, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_writeNumber (lcd_str_config_t *ptr_str_config, sint16_t copy_s16_value, uint8_t copy_u8_width)
+{
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	uint8_t u8_arr_text[FORMAT_BUFFER_SIZE];
+	if(ptr_str_config == NULL)
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else if(FORMAT_s16(copy_s16_value, copy_u8_width, FORMAT_PAD_SPACE, u8_arr_text) != FORMAT_E_OK)
+	{
+		enu_return_state = LCD_E_NOT_OK;
+	}
+	else
+	{
+		enu_return_state = LCD_writeString(ptr_str_config, u8_arr_text);
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Write a Q-format fixed-point value to the LCD.
+ *
+ * This function formats copy_s16_value / 2^copy_u8_frac_bits with copy_u8_decimals rounded decimals, right-aligned
+ * in a field of copy_u8_width characters, and writes it to the shadow buffer at the cursor position.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] copy_s16_value Raw fixed-point value.
+ * @param[in] copy_u8_frac_bits Number of fractional bits.
+ * @param[in] copy_u8_decimals Digits after the decimal point.
+ * @param[in] copy_u8_width Minimum field width including sign and point.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if an argument is out of range, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_writeFixed (lcd_str_config_t *ptr_str_config, sint16_t copy_s16_value, uint8_t copy_u8_frac_bits, uint8_t copy_u8_decimals, uint8_t copy_u8_width)
+{
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	uint8_t u8_arr_text[FORMAT_BUFFER_SIZE];
+	if(ptr_str_config == NULL)
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else if(FORMAT_q16(copy_s16_value, copy_u8_frac_bits, copy_u8_decimals, copy_u8_width, FORMAT_PAD_SPACE, u8_arr_text) != FORMAT_E_OK)
+	{
+		enu_return_state = LCD_E_NOT_OK;
+	}
+	else
+	{
+		enu_return_state = LCD_writeString(ptr_str_config, u8_arr_text);
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Write a special character to the LCD.
+ *
+ * This function writes a special character to the LCD screen. The bitmap is uploaded only when it is not
+ * already resident in CGRAM.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] u8_SpChar The type of special character to be written.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the character type is unknown.
+ */
+lcd_enu_return_state_t LCD_writeSpChar (lcd_str_config_t *ptr_str_config, u8_en_lcdSpCharType u8_SpChar)
+{   lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	uint8_t u8_code;
+	if(u8_SpChar >= LCD_SP_CHAR_COUNT)
+	{
+		enu_return_state = LCD_E_NOT_OK;
+	}
+	else
+	{
+		enu_return_state = LCD_glyphAcquire(ptr_str_config, &gs_str_arr_spChar[u8_SpChar], &u8_code);
+		if(enu_return_state == LCD_E_OK)
+		{
+			LCD_shadowPut(LCD_ROW_2, LCD_COL_1, u8_code);
+		}
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Get the character code of a glyph, loading it into CGRAM if it is not resident.
+ *
+ * This function looks the glyph up in the slot table. A miss reuses the least recently used slot, which is a
+ * free slot as long as fewer than 8 glyphs have been loaded.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] ptr_str_glyph Pointer to the glyph bitmap.
+ * @param[out] ptr_u8_code Character code to write to DDRAM.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the upload was refused by a full queue, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_glyphAcquire (lcd_str_config_t *ptr_str_config, const lcd_str_glyph_t *ptr_str_glyph, uint8_t *ptr_u8_code)
+{
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	uint8_t u8_rank = U8_ZERO_VALUE;
+	uint8_t u8_slot;
+	if((ptr_str_config == NULL) || (ptr_str_glyph == NULL) || (ptr_u8_code == NULL))
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else
+	{
+		while((u8_rank < (LCD_CGRAM_SLOTS - U8_ONE_VALUE)) && (gs_ptr_str_arr_slotGlyph[gs_u8_arr_slotOrder[u8_rank]] != ptr_str_glyph))
+		{
+			u8_rank++;
+		}
+		u8_slot = gs_u8_arr_slotOrder[u8_rank];
+		
+		if(gs_ptr_str_arr_slotGlyph[u8_slot] != ptr_str_glyph)
+		{
+			/* miss: u8_rank stopped on the least recently used slot */
+			enu_return_state = LCD_cmd(ptr_str_config, LCD_CGRAM_START_ADD + (u8_slot * LCD_GLYPH_ROWS));
+			for(uint8_t u8_row = U8_ZERO_VALUE; (u8_row < LCD_GLYPH_ROWS) && (enu_return_state == LCD_E_OK); u8_row++)
+			{
+				enu_return_state = LCD_char(ptr_str_config, ptr_str_glyph->u8_arr_rows[u8_row]);
+			}
+			/* a partly uploaded slot holds no known glyph */
+			gs_ptr_str_arr_slotGlyph[u8_slot] = (enu_return_state == LCD_E_OK) ? ptr_str_glyph : NULL;
+		}
+		
+		/* move the slot to the most recently used position */
+		for(; u8_rank > U8_ZERO_VALUE; u8_rank--)
+		{
+			gs_u8_arr_slotOrder[u8_rank] = gs_u8_arr_slotOrder[u8_rank - U8_ONE_VALUE];
+		}
+		gs_u8_arr_slotOrder[U8_ZERO_VALUE] = u8_slot;
+		*ptr_u8_code = LCD_CGRAM_CODE_BASE + u8_slot;
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Write a glyph to the LCD.
+ *
+ * This function writes the code of the glyph to the shadow buffer at the cursor position.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] ptr_str_glyph Pointer to the glyph bitmap.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_writeGlyph (lcd_str_config_t *ptr_str_config, const lcd_str_glyph_t *ptr_str_glyph)
+{
+	lcd_enu_return_state_t enu_return_state;
+	uint8_t u8_code;
+	enu_return_state = LCD_glyphAcquire(ptr_str_config, ptr_str_glyph, &u8_code);
+	if((enu_return_state == LCD_E_OK) && (gs_u8_cursorCol < LCD_COLS_MAX))
+	{
+		LCD_shadowPut(gs_u8_cursorRow, gs_u8_cursorCol, u8_code);
+		gs_u8_cursorCol++;
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Place an empty bargraph on the LCD.
+ *
+ * This function records the position of the bar and blanks its cells in the shadow buffer.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[out] ptr_str_bar Pointer to the bargraph to initialize.
+ * @param[in] copy_enu_row Row of the bar.
+ * @param[in] copy_enu_col First column of the bar.
+ * @param[in] copy_u8_cells Width of the bar in cells.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the bar does not fit, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_bargraphInit (lcd_str_config_t *ptr_str_config, lcd_str_bargraph_t *ptr_str_bar, lcd_enu_row_select_t copy_enu_row, lcd_enu_col_select_t copy_enu_col, uint8_t copy_u8_cells)
+{
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	if((ptr_str_config == NULL) || (ptr_str_bar == NULL))
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else if((copy_enu_row >= LCD_ROWS_MAX) || (copy_u8_cells == U8_ZERO_VALUE) || (copy_enu_col >= LCD_COLS_MAX) || (copy_u8_cells > (LCD_COLS_MAX - copy_enu_col)))
+	{
+		enu_return_state = LCD_E_NOT_OK;
+	}
+	else
+	{
+		ptr_str_bar->u8_row = copy_enu_row;
+		ptr_str_bar->u8_col = copy_enu_col;
+		ptr_str_bar->u8_cells = copy_u8_cells;
+		ptr_str_bar->u8_level = U8_ZERO_VALUE;
+		for(uint8_t u8_cell = U8_ZERO_VALUE; u8_cell < copy_u8_cells; u8_cell++)
+		{
+			LCD_shadowPut(copy_enu_row, copy_enu_col + u8_cell, LCD_BLANK_CHAR);
+		}
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Set the fill level of a bargraph.
+ *
+ * This function redraws the cells from the one holding the lower of the old and new levels up to the one holding
+ * the higher level. The cells outside that range keep their content.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in,out] ptr_str_bar Pointer to the bargraph.
+ * @param[in] copy_u8_level New level in sub-steps.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the level exceeds the bar, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_bargraphSet (lcd_str_config_t *ptr_str_config, lcd_str_bargraph_t *ptr_str_bar, uint8_t copy_u8_level)
+{
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	uint8_t u8_max_level;
+	uint8_t u8_low_level;
+	uint8_t u8_high_level;
+	if((ptr_str_config == NULL) || (ptr_str_bar == NULL))
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else
+	{
+		u8_max_level = ptr_str_bar->u8_cells * LCD_BAR_STEPS_PER_CELL;
+		if(copy_u8_level > u8_max_level)
+		{
+			copy_u8_level = u8_max_level;
+			enu_return_state = LCD_E_NOT_OK;
+		}
+		if(copy_u8_level < ptr_str_bar->u8_level)
+		{
+			u8_low_level = copy_u8_level;
+			u8_high_level = ptr_str_bar->u8_level;
+		}
+		else
+		{
+			u8_low_level = ptr_str_bar->u8_level;
+			u8_high_level = copy_u8_level;
+		}
+		ptr_str_bar->u8_level = copy_u8_level;
+		
+		if(u8_high_level != u8_low_level)
+		{
+			/* cell n shows the levels above n * LCD_BAR_STEPS_PER_CELL up to (n + 1) * LCD_BAR_STEPS_PER_CELL */
+			for(uint8_t u8_cell = u8_low_level / LCD_BAR_STEPS_PER_CELL; u8_cell <= ((u8_high_level - U8_ONE_VALUE) / LCD_BAR_STEPS_PER_CELL); u8_cell++)
+			{
+				LCD_bargraphDrawCell(ptr_str_config, ptr_str_bar, u8_cell);
+			}
+		}
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Send the changed cells of the shadow buffer to the LCD.
+ *
+ * This function walks the dirty cells of each row and sends them in runs, issuing one set-address command
+ * per run. Short gaps of unchanged cells inside a run are rewritten rather than skipped with another
+ * set-address command.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_refresh (lcd_str_config_t *ptr_str_config)
+{
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	uint8_t u8_col;
+	uint8_t u8_next_dirty;
+	uint8_t u8_address_col;
+	if(ptr_str_config == NULL)
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else if((gs_u8_frameDepth != U8_ZERO_VALUE) || (gs_u8_marqueeActive == TRUE))
+	{
+		//deferred to LCD_endFrame or to the end of the marquee
+	}
+	else
+	{
+		/* a transfer refused by a full queue leaves its cell dirty for the next refresh */
+		for(uint8_t u8_row = U8_ZERO_VALUE; (u8_row < LCD_ROWS_MAX) && (enu_return_state == LCD_E_OK); u8_row++)
+		{
+			u8_col = U8_ZERO_VALUE;
+			while((gs_u16_arr_dirty[u8_row] != U8_ZERO_VALUE) && (enu_return_state == LCD_E_OK))
+			{
+				u8_col = LCD_nextDirty(u8_row, u8_col);
+				u8_address_col = LCD_addressColumn(u8_row);
+				if((u8_address_col <= u8_col) && ((u8_col - u8_address_col) <= LCD_REFRESH_GAP_MAX))
+				{
+					/* the address counter already sits on the run or just before it: rewrite the gap instead of moving it */
+					u8_col = u8_address_col;
+				}
+				else
+				{
+					enu_return_state = LCD_cmd(ptr_str_config, gs_u8_arr_rowAddress[u8_row] + u8_col);
+				}
+				if(enu_return_state == LCD_E_OK)
+				{
+					do{
+						/* the address counter auto-increments, so a run only needs its first address */
+						enu_return_state = LCD_char(ptr_str_config, gs_u8_arr_shadow[u8_row][u8_col]);
+						if(enu_return_state == LCD_E_OK)
+						{
+							gs_u16_arr_dirty[u8_row] &= (uint16_t)~LCD_COL_BIT(u8_col);
+							u8_col++;
+						}
+						u8_next_dirty = LCD_nextDirty(u8_row, u8_col);
+					}while((enu_return_state == LCD_E_OK) && (u8_next_dirty < LCD_COLS_MAX) && ((u8_next_dirty - u8_col) <= LCD_REFRESH_GAP_MAX));
+				}
+			}
+		}
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Send a command to the LCD.
+ *
+ * This function sends a command to the LCD screen. With the asynchronous transfer mode the command is queued
+ * and the function returns immediately.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] cmd The command to be sent.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if sending the command failed.
+ */
+lcd_enu_return_state_t LCD_cmd(lcd_str_config_t *ptr_str_config,uint8_t cmd)
+{
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	LCD_trackCommand(cmd);
+	if((gs_ptr_str_queueConfig != NULL) && (ptr_str_config->enu_transfer == LCD_TRANSFER_ASYNC))
+	{
+		enu_return_state = LCD_enqueue(cmd);
+	}
+	else
+	{
+		enu_return_state = LCD_waitPowerUp();
+		if(enu_return_state == LCD_E_OK)
+		{
+			enu_return_state = LCD_sendByte(ptr_str_config, cmd, DIO_PIN_LOW_LEVEL);
+		}
+	}
+	if(enu_return_state != LCD_E_OK)
+	{
+		/* the controller never saw the command */
+		gs_u8_addressCounter = LCD_ADDRESS_UNKNOWN;
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Write a character to the LCD.
+ *
+ * This function writes a character to the LCD screen. With the asynchronous transfer mode the character is
+ * queued and the function returns immediately.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] cmd The character to be written.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the character was not sent or queued.
+ */
+lcd_enu_return_state_t LCD_char(lcd_str_config_t *ptr_str_config, uint8_t cmd)
+{
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	LCD_trackData();
+	if((gs_ptr_str_queueConfig != NULL) && (ptr_str_config->enu_transfer == LCD_TRANSFER_ASYNC))
+	{
+		enu_return_state = LCD_enqueue(LCD_QUEUE_DATA_FLAG | cmd);
+	}
+	else
+	{
+		enu_return_state = LCD_waitPowerUp();
+		if(enu_return_state == LCD_E_OK)
+		{
+			enu_return_state = LCD_sendByte(ptr_str_config, cmd, DIO_PIN_HIGH_LEVEL);
+		}
+	}
+	if(enu_return_state != LCD_E_OK)
+	{
+		/* the address counter did not move */
+		gs_u8_addressCounter = LCD_ADDRESS_UNKNOWN;
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Scroll a message through a row with the controller's display shift.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[in] copy_enu_row Row of the message.
+ * @param[in] ptr_u8_text Flash address of the null-terminated message, declared PROGMEM.
+ * @param[in] copy_u16_step_ms Time between two shift steps, 1 .. LCD_MARQUEE_STEP_MS_MAX.
+ * @param[in] copy_u8_steps Shift steps before the marquee ends by itself, or LCD_MARQUEE_ENDLESS.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if the marquee cannot start, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_marqueeStart (lcd_str_config_t *ptr_str_config, lcd_enu_row_select_t copy_enu_row, const uint8_t *ptr_u8_text, uint16_t copy_u16_step_ms, uint8_t copy_u8_steps)
+{
+	lcd_enu_return_state_t enu_return_state = LCD_E_OK;
+	uint8_t u8_char = LCD_BLANK_CHAR;
+	uint8_t u8_end = FALSE;
+	if((ptr_str_config == NULL) || (ptr_u8_text == NULL))
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else if((copy_enu_row >= LCD_ROWS_MAX) || (copy_u16_step_ms == U8_ZERO_VALUE) || (copy_u16_step_ms > LCD_MARQUEE_STEP_MS_MAX))
+	{
+		enu_return_state = LCD_E_NOT_OK;
+	}
+	else if((gs_ptr_str_queueConfig == NULL) || (ptr_str_config->enu_transfer != LCD_TRANSFER_ASYNC) || (gs_u8_marqueeActive == TRUE))
+	{
+		/* the steps are sent by the tick, which only owns the bus in the asynchronous mode */
+		enu_return_state = LCD_E_NOT_OK;
+	}
+	else
+	{
+		/* load the whole DDRAM line once, blanks after the message */
+		enu_return_state = LCD_cmd(ptr_str_config, gs_u8_arr_rowAddress[copy_enu_row]);
+		for(uint8_t u8_col = U8_ZERO_VALUE; (u8_col < LCD_MARQUEE_TEXT_MAX) && (enu_return_state == LCD_E_OK); u8_col++)
+		{
+			if(u8_end == FALSE)
+			{
+				u8_char = pgm_read_byte(&ptr_u8_text[u8_col]);
+				if(u8_char == '\0')
+				{
+					u8_end = TRUE;
+					u8_char = LCD_BLANK_CHAR;
+				}
+			}
+			enu_return_state = LCD_char(ptr_str_config, u8_char);
+			if((u8_col < LCD_COLS_MAX) && (enu_return_state == LCD_E_OK))
+			{
+				/* the visible cells now show the message, the shadow follows the panel */
+				gs_u8_arr_shadow[copy_enu_row][u8_col] = u8_char;
+				gs_u16_arr_dirty[copy_enu_row] &= (uint16_t)~LCD_COL_BIT(u8_col);
+			}
+		}
+		/* the tick ends the marquee with a return home, which moves the address counter behind our back */
+		gs_u8_addressCounter = LCD_ADDRESS_UNKNOWN;
+		
+		if(enu_return_state == LCD_E_OK)
+		{
+			gs_u16_marqueePeriod = copy_u16_step_ms * LCD_QUEUE_TICKS_PER_MS;
+			gs_u16_marqueeCountdown = gs_u16_marqueePeriod;
+			gs_u8_marqueeStepsLeft = copy_u8_steps;
+			gs_u8_marqueeStop = FALSE;
+			gs_u8_marqueeDone = FALSE;
+			gs_u8_marqueeActive = TRUE;
+			LCD_queueTickStart();
+		}
+		else
+		{
+			/* the line was refused by a full queue: the visible cells are resent on the next refresh */
+			for(uint8_t u8_col = U8_ZERO_VALUE; u8_col < LCD_COLS_MAX; u8_col++)
+			{
+				gs_u16_arr_dirty[copy_enu_row] |= LCD_COL_BIT(u8_col);
+			}
+		}
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief End the running marquee.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_marqueeStop (lcd_str_config_t *ptr_str_config)
+{
+	lcd_enu_return_state_t enu_return_state = LCD_E_OK;
+	if(ptr_str_config == NULL)
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else if(gs_u8_marqueeActive == TRUE)
+	{
+		gs_u8_marqueeStop = TRUE;
+	}
+	else
+	{
+		//no marquee running
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Check whether a marquee is running.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[out] ptr_u8_active TRUE until the display is back at its start position, FALSE otherwise.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_marqueeIsActive (lcd_str_config_t *ptr_str_config, uint8_t *ptr_u8_active)
+{
+	lcd_enu_return_state_t enu_return_state = LCD_E_OK;
+	if((ptr_str_config == NULL) || (ptr_u8_active == NULL))
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else
+	{
+		*ptr_u8_active = gs_u8_marqueeActive;
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Open a frame.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if frames are nested too deep, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_beginFrame (lcd_str_config_t *ptr_str_config)
+{
+	lcd_enu_return_state_t enu_return_state = LCD_E_OK;
+	if(ptr_str_config == NULL)
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else if(gs_u8_frameDepth == LCD_FRAME_DEPTH_MAX)
+	{
+		enu_return_state = LCD_E_NOT_OK;
+	}
+	else
+	{
+		gs_u8_frameDepth++;
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Close a frame.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @return Operation status: LCD_E_OK if successful, LCD_E_NOT_OK if no frame is open, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_endFrame (lcd_str_config_t *ptr_str_config)
+{
+	lcd_enu_return_state_t enu_return_state = LCD_E_OK;
+	if(ptr_str_config == NULL)
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else if(gs_u8_frameDepth == U8_ZERO_VALUE)
+	{
+		enu_return_state = LCD_E_NOT_OK;
+	}
+	else
+	{
+		gs_u8_frameDepth--;
+		enu_return_state = LCD_refresh(ptr_str_config);
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Wait until every queued transfer has reached the controller.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_flush (lcd_str_config_t *ptr_str_config)
+{
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	if(ptr_str_config == NULL)
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else if(gs_ptr_str_queueConfig != NULL)
+	{
+		while((gs_u8_queueHead != gs_u8_queueTail) || (gs_u8_queueWaitTicks != U8_ZERO_VALUE) || (LCD_busInFlight(ptr_str_config) == TRUE));
+	}
+	else
+	{
+		//blocking transfers are complete on return
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Check whether the power-up sequence has completed.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[out] ptr_u8_ready TRUE once the controller is initialized, FALSE while the sequence is running.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_isReady (lcd_str_config_t *ptr_str_config, uint8_t *ptr_u8_ready)
+{
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	if((ptr_str_config == NULL) || (ptr_u8_ready == NULL))
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else
+	{
+		*ptr_u8_ready = gs_u8_ready;
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Check whether the transmit queue is drained.
+ *
+ * @param[in] ptr_str_config Pointer to the LCD configuration structure.
+ * @param[out] ptr_u8_idle TRUE if no transfer is queued or in progress, FALSE otherwise.
+ * @return Operation status: LCD_E_OK if successful, LCD_NULL_PTR if NULL pointer provided.
+ */
+lcd_enu_return_state_t LCD_isIdle (lcd_str_config_t *ptr_str_config, uint8_t *ptr_u8_idle)
+{
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	if((ptr_str_config == NULL) || (ptr_u8_idle == NULL))
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else if((gs_u8_queueHead != gs_u8_queueTail) || (gs_u8_queueWaitTicks != U8_ZERO_VALUE) || (LCD_busInFlight(ptr_str_config) == TRUE))
+	{
+		*ptr_u8_idle = FALSE;
+	}
+	else
+	{
+		*ptr_u8_idle = TRUE;
+	}
+	return enu_return_state;
+}
+
+static lcd_enu_return_state_t LCD_sendByte(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_data, dio_enu_level_t copy_enu_rs_level)
+{
+	lcd_enu_return_state_t enu_return_state;
+	enu_return_state = LCD_transferByte(ptr_str_config, copy_u8_data, copy_enu_rs_level);
+	
+	/* the execution time counts from the last enable pulse, at the end of the backpack transaction */
+	while(LCD_busInFlight(ptr_str_config) == TRUE);
+	if(enu_return_state == LCD_E_OK)
+	{
+		LCD_waitReady(ptr_str_config, copy_u8_data, copy_enu_rs_level);
+	}
+	return enu_return_state;
+}
+
+static lcd_enu_return_state_t LCD_transferByte(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_data, dio_enu_level_t copy_enu_rs_level)
+{
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	if(ptr_str_config->enu_bus == LCD_BUS_PCF8574)
+	{
+		LCD_busFrame(ptr_str_config, copy_u8_data, copy_enu_rs_level, LCD_PCF8574_FRAME_SIZE / 2);
+	}
+	else
+	{
+		DIO_write_pin(ptr_str_config->str_Epin.enu_port,ptr_str_config->str_Epin.enu_pin,DIO_PIN_LOW_LEVEL);
+		DIO_write_pin(ptr_str_config->str_RSpin.enu_port,ptr_str_config->str_RSpin.enu_pin,copy_enu_rs_level);
+		DIO_write_pin(ptr_str_config->str_RWpin.enu_port,ptr_str_config->str_RWpin.enu_pin,DIO_PIN_LOW_LEVEL);
+		if(ptr_str_config->enu_mode == LCD_4_BIT_MODE)
+		{
+			/* the controller needs no wait between the two nibbles of one byte */
+			LCD_writeNibble(ptr_str_config, copy_u8_data >> LCD_MAX_DATA_PINS_MOD_4);
+			LCD_writeNibble(ptr_str_config, copy_u8_data);
+		}
+		else if((ptr_str_config->enu_mode == LCD_8_BIT_MODE) && (gs_u8_dataPortWrite == TRUE))
+		{
+			/* D0..D7 own the whole port: one register write per byte and a single enable pulse */
+			DIO_set_port(gs_enu_dataPort, copy_u8_data);
+			ENABLE(ptr_str_config);
+		}
+		else if(ptr_str_config->enu_mode == LCD_8_BIT_MODE)
+		{
+			/* data pin n carries bit n, as in the 4-bit path */
+			for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < LCD_MAX_DATA_PINS_MOD_8; u8_counter++){
+				if(READ_BIT(copy_u8_data,u8_counter) == U8_ONE_VALUE){
+					DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_HIGH_LEVEL);
+					}else{
+					DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_LOW_LEVEL);
+				}
+			}
+			ENABLE(ptr_str_config);
+		}
+		else
+		{
+			//do nothing
+			enu_return_state=LCD_E_NOT_OK;
+		}
+	}
+	return enu_return_state;
+}
+
+static void LCD_transferWakeUp(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_cmd)
+{
+	if(ptr_str_config->enu_bus == LCD_BUS_PCF8574)
+	{
+		LCD_busFrame(ptr_str_config, copy_u8_cmd, DIO_PIN_LOW_LEVEL, U8_ONE_VALUE);
+	}
+	else if(ptr_str_config->enu_mode == LCD_4_BIT_MODE)
+	{
+		DIO_write_pin(ptr_str_config->str_Epin.enu_port,ptr_str_config->str_Epin.enu_pin,DIO_PIN_LOW_LEVEL);
+		DIO_write_pin(ptr_str_config->str_RSpin.enu_port,ptr_str_config->str_RSpin.enu_pin,DIO_PIN_LOW_LEVEL);
+		DIO_write_pin(ptr_str_config->str_RWpin.enu_port,ptr_str_config->str_RWpin.enu_pin,DIO_PIN_LOW_LEVEL);
+		LCD_writeNibble(ptr_str_config, copy_u8_cmd >> LCD_MAX_DATA_PINS_MOD_4);
+	}
+	else
+	{
+		LCD_transferByte(ptr_str_config, copy_u8_cmd, DIO_PIN_LOW_LEVEL);
+	}
+}
+
+static void LCD_busFrame(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_data, dio_enu_level_t copy_enu_rs_level, uint8_t copy_u8_nibbles)
+{
+	uint8_t u8_control = LCD_PCF8574_BACKLIGHT;
+	uint8_t u8_index = U8_ZERO_VALUE;
+	uint8_t u8_port;
+	if(copy_enu_rs_level == DIO_PIN_HIGH_LEVEL)
+	{
+		u8_control |= LCD_PCF8574_RS;
+	}
+	
+	/* the frame buffer is read by the TWI interrupt until the previous transaction ends */
+	while(LCD_busInFlight(ptr_str_config) == TRUE);
+	for(uint8_t u8_nibble = U8_ZERO_VALUE; u8_nibble < copy_u8_nibbles; u8_nibble++)
+	{
+		/* high nibble first; each nibble is latched on the falling edge of E */
+		u8_port = (uint8_t)(copy_u8_data & (LCD_NIBBLE_MASK << LCD_PCF8574_DATA_SHIFT)) | u8_control;
+		gs_u8_arr_busFrame[u8_index++] = u8_port | LCD_PCF8574_E;
+		gs_u8_arr_busFrame[u8_index++] = u8_port;
+		copy_u8_data <<= LCD_MAX_DATA_PINS_MOD_4;
+	}
+	TWI_masterWrite(ptr_str_config->u8_i2c_address, gs_u8_arr_busFrame, u8_index);
+}
+
+static uint8_t LCD_busInFlight(lcd_str_config_t *ptr_str_config)
+{
+	uint8_t u8_idle = TRUE;
+	if(ptr_str_config->enu_bus == LCD_BUS_PCF8574)
+	{
+		TWI_isIdle(&u8_idle);
+	}
+	return (u8_idle == TRUE) ? FALSE : TRUE;
+}
+
+static void LCD_writeNibble(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_nibble)
+{
+	if(gs_u8_dataPortWrite == TRUE)
+	{
+		DIO_write_port(gs_enu_dataPort, gs_u8_dataMask, (uint8_t)(copy_u8_nibble << gs_u8_dataShift));
+	}
+	else
 	{
 		for(sint8_t u8_counter = LCD_MAX_DATA_PINS_MOD_4 - U8_ONE_VALUE; u8_counter >= U8_ZERO_VALUE; u8_counter--){
-			if(READ_BIT(cmd,u8_bit_counter) == U8_ONE_VALUE){
+			if(READ_BIT(copy_u8_nibble,u8_counter) == U8_ONE_VALUE){
 				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_HIGH_LEVEL);
 			}else{
 				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_LOW_LEVEL);
 			}
-			u8_bit_counter--;
 		}
-		ENABLE(ptr_str_config);
-		delay_3_ms();
-	   for(sint8_t u8_counter = LCD_MAX_DATA_PINS_MOD_4-U8_ONE_VALUE; u8_counter >= U8_ZERO_VALUE; u8_counter--){
-		   if(READ_BIT(cmd,u8_bit_counter) == U8_ONE_VALUE){
-			   DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_HIGH_LEVEL);
-			}else{
-			   DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_LOW_LEVEL);
-		   }
-		   u8_bit_counter--;
-	   }
-		ENABLE(ptr_str_config);
-		delay_3_ms();
 	}
-	else if(ptr_str_config->enu_mode == LCD_8_BIT_MODE)
+	ENABLE(ptr_str_config);
+}
+
+static void LCD_waitReady(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_data, dio_enu_level_t copy_enu_rs_level)
+{
+	uint8_t u8_poll_counter = U8_ZERO_VALUE;
+	dio_enu_level_t enu_busy_flag = DIO_PIN_HIGH_LEVEL;
+	if(gs_u8_busyFlagActive == FALSE)
+	{
+		LCD_waitExecTime(copy_u8_data, copy_enu_rs_level);
+	}
+	else
 	{
-		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < LCD_MAX_DATA_PINS_MOD_8; u8_counter++){
-			if(READ_BIT(cmd,u8_bit_counter) == U8_ONE_VALUE){
-				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_HIGH_LEVEL);
-				}else{
-				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_LOW_LEVEL);
-			}
-			u8_bit_counter--;
+		while((enu_busy_flag == DIO_PIN_HIGH_LEVEL) && (u8_poll_counter < LCD_BUSY_FLAG_POLL_MAX))
+		{
+			enu_busy_flag = LCD_readBusyFlag(ptr_str_config);
+			u8_poll_counter++;
+		}
+		
+		if(enu_busy_flag == DIO_PIN_HIGH_LEVEL)
+		{
+			/* no answer from the controller, fall back to the datasheet timing */
+			LCD_waitExecTime(copy_u8_data, copy_enu_rs_level);
 		}
-		ENABLE(ptr_str_config);
-		delay_3_ms();	
+	}
+}
+
+static void LCD_waitExecTime(uint8_t copy_u8_data, dio_enu_level_t copy_enu_rs_level)
+{
+	if(copy_enu_rs_level == DIO_PIN_HIGH_LEVEL)
+	{
+		DELAY_US(LCD_DATA_EXEC_TIME_US);
+	}
+	else if(copy_u8_data <= LCD_LONG_CMD_MAX)
+	{
+		DELAY_US(LCD_LONG_CMD_EXEC_TIME_US);
 	}
 	else
 	{
-		//do nothing
-		enu_return_state=LCD_E_NOT_OK;
+		DELAY_US(LCD_CMD_EXEC_TIME_US);
 	}
-	delay_3_ms();
-	return enu_return_state;
 }
 
-/**
- * @brief Write a character to the LCD.
- *
- * This function writes a character to the LCD screen.
- *
- * @param[in] ptr_str_config Pointer to the LCD configuration structure.
- * @param[in] cmd The character to be written.
- */
-void LCD_char(lcd_str_config_t *ptr_str_config, uint8_t cmd)
+static dio_enu_level_t LCD_readBusyFlag(lcd_str_config_t *ptr_str_config)
 {
-	lcd_enu_return_state_t u8_bit_counter = LCD_MSB_INDEX;
-	DIO_write_pin(ptr_str_config->str_Epin.enu_port,ptr_str_config->str_Epin.enu_pin,DIO_PIN_LOW_LEVEL);
-	DIO_write_pin(ptr_str_config->str_RSpin.enu_port,ptr_str_config->str_RSpin.enu_pin,DIO_PIN_HIGH_LEVEL);
-	DIO_write_pin(ptr_str_config->str_RWpin.enu_port,ptr_str_config->str_RWpin.enu_pin,DIO_PIN_LOW_LEVEL);
+	uint8_t u8_data_pins;
+	uint8_t u8_busy_pin;
+	dio_enu_level_t enu_busy_flag = DIO_PIN_HIGH_LEVEL;
+	if(ptr_str_config->enu_mode == LCD_4_BIT_MODE)
+	{
+		u8_data_pins = LCD_MAX_DATA_PINS_MOD_4;
+		u8_busy_pin = LCD_MAX_DATA_PINS_MOD_4 - U8_ONE_VALUE;
+	}
+	else
+	{
+		/* BF is on D7, the last data pin */
+		u8_data_pins = LCD_MAX_DATA_PINS_MOD_8;
+		u8_busy_pin = LCD_MSB_INDEX;
+	}
 	
+	/* release the data lines and read the instruction register */
+	if(gs_u8_dataPortWrite == TRUE)
+	{
+		DIO_init_port(gs_enu_dataPort, gs_u8_dataMask, DIO_PIN_INPUT);
+	}
+	else
+	{
+		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < u8_data_pins; u8_counter++){
+			DIO_init(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin, DIO_PIN_INPUT);
+		}
+	}
+	DIO_write_pin(ptr_str_config->str_RSpin.enu_port,ptr_str_config->str_RSpin.enu_pin,DIO_PIN_LOW_LEVEL);
+	DIO_write_pin(ptr_str_config->str_RWpin.enu_port,ptr_str_config->str_RWpin.enu_pin,DIO_PIN_HIGH_LEVEL);
 	
+	DIO_write_pin(ptr_str_config->str_Epin.enu_port, ptr_str_config->str_Epin.enu_pin, DIO_PIN_HIGH_LEVEL);
+	DELAY_US(LCD_ENABLE_PULSE_US);
+	DIO_read_pin(ptr_str_config->str_data_pins[u8_busy_pin].enu_port, ptr_str_config->str_data_pins[u8_busy_pin].enu_pin, &enu_busy_flag);
+	DIO_write_pin(ptr_str_config->str_Epin.enu_port, ptr_str_config->str_Epin.enu_pin, DIO_PIN_LOW_LEVEL);
 	if(ptr_str_config->enu_mode == LCD_4_BIT_MODE)
 	{
-		
-		for(sint8_t u8_counter = LCD_MAX_DATA_PINS_MOD_4-U8_ONE_VALUE; u8_counter >= U8_ZERO_VALUE; u8_counter--){
-			if(READ_BIT(cmd,u8_bit_counter) == U8_ONE_VALUE){
-				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_HIGH_LEVEL);
-				}else{
-				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_LOW_LEVEL);
-			}
-			u8_bit_counter--;
+		/* clock out the low nibble of the address counter to complete the read */
+		DIO_write_pin(ptr_str_config->str_Epin.enu_port, ptr_str_config->str_Epin.enu_pin, DIO_PIN_HIGH_LEVEL);
+		DELAY_US(LCD_ENABLE_PULSE_US);
+		DIO_write_pin(ptr_str_config->str_Epin.enu_port, ptr_str_config->str_Epin.enu_pin, DIO_PIN_LOW_LEVEL);
+	}
+	
+	DIO_write_pin(ptr_str_config->str_RWpin.enu_port,ptr_str_config->str_RWpin.enu_pin,DIO_PIN_LOW_LEVEL);
+	if(gs_u8_dataPortWrite == TRUE)
+	{
+		DIO_init_port(gs_enu_dataPort, gs_u8_dataMask, DIO_PIN_OUTPUT);
+	}
+	else
+	{
+		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < u8_data_pins; u8_counter++){
+			DIO_init(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin, DIO_PIN_OUTPUT);
 		}
-		ENABLE(ptr_str_config);
-		delay_3_ms();
-		for(sint8_t u8_counter = LCD_MAX_DATA_PINS_MOD_4-U8_ONE_VALUE; u8_counter >= U8_ZERO_VALUE; u8_counter--){
-			if(READ_BIT(cmd,u8_bit_counter) == U8_ONE_VALUE){
-				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_HIGH_LEVEL);
-				}else{
-				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_LOW_LEVEL);
-			}
-			u8_bit_counter--;
+	}
+	return enu_busy_flag;
+}
+
+static void LCD_detectDataPort(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_data_pins)
+{
+	uint8_t u8_expected_pin;
+	gs_enu_dataPort = ptr_str_config->str_data_pins[U8_ZERO_VALUE].enu_port;
+	gs_u8_dataPortWrite = TRUE;
+	if(copy_u8_data_pins == LCD_MAX_DATA_PINS_MOD_4)
+	{
+		/* D4..D7 on consecutive pins of one port, D4 lowest */
+		gs_u8_dataShift = ptr_str_config->str_data_pins[U8_ZERO_VALUE].enu_pin;
+		gs_u8_dataMask = (uint8_t)(LCD_NIBBLE_MASK << gs_u8_dataShift);
+	}
+	else
+	{
+		/* D0..D7 on pins 0..7 of one port */
+		gs_u8_dataShift = U8_ZERO_VALUE;
+		gs_u8_dataMask = U8_BIT_REG_MASK;
+	}
+	for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < copy_u8_data_pins; u8_counter++)
+	{
+		u8_expected_pin = gs_u8_dataShift + u8_counter;
+		if((ptr_str_config->str_data_pins[u8_counter].enu_port != gs_enu_dataPort) || (ptr_str_config->str_data_pins[u8_counter].enu_pin != u8_expected_pin))
+		{
+			/* scattered wiring keeps the per-pin path */
+			gs_u8_dataPortWrite = FALSE;
 		}
-		ENABLE(ptr_str_config);
-		delay_3_ms();
 	}
-	else if(ptr_str_config->enu_mode == LCD_8_BIT_MODE)
+}
+
+static lcd_enu_return_state_t LCD_enqueue(uint16_t copy_u16_entry)
+{
+	lcd_enu_return_state_t enu_return_state = LCD_E_OK;
+	uint8_t u8_next_head = (gs_u8_queueHead + U8_ONE_VALUE) & LCD_QUEUE_MASK;
+	
+	/* a full queue waits for the tick interrupt to send the oldest entry, which it cannot do with interrupts off */
+	while((u8_next_head == gs_u8_queueTail) && (READ_BIT(ISR_SREG, ISR_SREG_I_BIT) == U8_ONE_VALUE));
+	if(u8_next_head == gs_u8_queueTail)
+	{
+		enu_return_state = LCD_E_NOT_OK;
+	}
+	else
 	{
-		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < LCD_MAX_DATA_PINS_MOD_8; u8_counter++){
-			if(READ_BIT(cmd,u8_bit_counter) == U8_ONE_VALUE){
-				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_HIGH_LEVEL);
-				}else{
-				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_LOW_LEVEL);
+		gs_u16_arr_queue[gs_u8_queueHead] = copy_u16_entry;
+		gs_u8_queueHead = u8_next_head;
+		/* checked after the store: a tick that found the queue empty has already cleared the flag */
+		LCD_queueTickStart();
+	}
+	return enu_return_state;
+}
+
+static void LCD_queueTickStart(void)
+{
+	/* the timer start enables interrupts, the caller's state is put back afterwards */
+	uint8_t u8_sreg = ISR_SREG;
+	cli();
+	if((gs_ptr_str_queueConfig != NULL) && (gs_u8_queueTickRunning == FALSE))
+	{
+		gs_u8_queueTickRunning = TRUE;
+		TIMER_MANGER_start(gs_str_queueTimerConfig.enu_prescaller, gs_str_queueTimerConfig.enu_timer_no);
+	}
+	ISR_SREG = u8_sreg;
+}
+
+static lcd_enu_return_state_t LCD_enqueueWait(uint16_t copy_u16_ticks)
+{
+	lcd_enu_return_state_t enu_return_state = LCD_E_OK;
+	while((copy_u16_ticks > LCD_QUEUE_WAIT_MAX) && (enu_return_state == LCD_E_OK))
+	{
+		enu_return_state = LCD_enqueue(LCD_QUEUE_WAIT_FLAG | LCD_QUEUE_WAIT_MAX);
+		copy_u16_ticks -= LCD_QUEUE_WAIT_MAX;
+	}
+	if(enu_return_state == LCD_E_OK)
+	{
+		enu_return_state = LCD_enqueue(LCD_QUEUE_WAIT_FLAG | copy_u16_ticks);
+	}
+	return enu_return_state;
+}
+
+static lcd_enu_return_state_t LCD_waitPowerUp(void)
+{
+	lcd_enu_return_state_t enu_return_state = LCD_E_OK;
+	
+	/* the tick clears the pointer when the blocking mode's power-up sequence is done */
+	while((gs_ptr_str_queueConfig != NULL) && (READ_BIT(ISR_SREG, ISR_SREG_I_BIT) == U8_ONE_VALUE));
+	if(gs_ptr_str_queueConfig != NULL)
+	{
+		enu_return_state = LCD_E_NOT_OK;
+	}
+	return enu_return_state;
+}
+
+static void LCD_queueTick(void)
+{
+	uint16_t u16_entry;
+	if(gs_ptr_str_queueConfig == NULL)
+	{
+		//queue not running
+	}
+	else if(LCD_busInFlight(gs_ptr_str_queueConfig) == TRUE)
+	{
+		/* waits and execution times count from the end of the backpack transaction */
+	}
+	else if(gs_u8_queueWaitTicks != U8_ZERO_VALUE)
+	{
+		gs_u8_queueWaitTicks--;
+	}
+	else if(gs_u8_queueHead != gs_u8_queueTail)
+	{
+		if((gs_u8_busyFlagActive == TRUE) && (LCD_readBusyFlag(gs_ptr_str_queueConfig) == DIO_PIN_HIGH_LEVEL))
+		{
+			//controller still busy, retry on the next tick
+		}
+		else
+		{
+			u16_entry = gs_u16_arr_queue[gs_u8_queueTail];
+			gs_u8_queueTail = (gs_u8_queueTail + U8_ONE_VALUE) & LCD_QUEUE_MASK;
+			if((u16_entry & LCD_QUEUE_WAIT_FLAG) != U8_ZERO_VALUE)
+			{
+				gs_u8_queueWaitTicks = (uint8_t)u16_entry;
+			}
+			else if((u16_entry & LCD_QUEUE_NIBBLE_FLAG) != U8_ZERO_VALUE)
+			{
+				LCD_transferWakeUp(gs_ptr_str_queueConfig, (uint8_t)u16_entry);
+			}
+			else if((u16_entry & LCD_QUEUE_READY_FLAG) != U8_ZERO_VALUE)
+			{
+				gs_u8_ready = TRUE;
+				if((gs_ptr_str_queueConfig->enu_sync == LCD_SYNC_BUSY_FLAG) && (gs_ptr_str_queueConfig->enu_bus == LCD_BUS_PARALLEL))
+				{
+					gs_u8_busyFlagActive = TRUE;
+				}
+				if(gs_ptr_str_queueConfig->enu_transfer == LCD_TRANSFER_BLOCKING)
+				{
+					/* later transfers are sent by the caller */
+					TIMER_MANGER_stop(LCD_QUEUE_TIMER);
+					gs_u8_queueTickRunning = FALSE;
+					gs_ptr_str_queueConfig = NULL;
+				}
 			}
-			u8_bit_counter--;
+			else if((u16_entry & LCD_QUEUE_DATA_FLAG) != U8_ZERO_VALUE)
+			{
+				LCD_transferByte(gs_ptr_str_queueConfig, (uint8_t)u16_entry, DIO_PIN_HIGH_LEVEL);
+			}
+			else
+			{
+				LCD_transferByte(gs_ptr_str_queueConfig, (uint8_t)u16_entry, DIO_PIN_LOW_LEVEL);
+				if((gs_u8_busyFlagActive == FALSE) && ((uint8_t)u16_entry <= LCD_LONG_CMD_MAX))
+				{
+					/* clear and return home take 1.52 ms instead of 37 us */
+					gs_u8_queueWaitTicks = LCD_QUEUE_LONG_CMD_TICKS;
+				}
+			}
+		}
+	}
+	else if(gs_u8_marqueeActive == TRUE)
+	{
+		LCD_marqueeTick();
+	}
+	else
+	{
+		/* nothing to send: the tick stays off until LCD_enqueue() or LCD_marqueeStart() restarts it */
+		TIMER_MANGER_stop(LCD_QUEUE_TIMER);
+		gs_u8_queueTickRunning = FALSE;
+	}
+}
+
+static void LCD_marqueeTick(void)
+{
+	if((gs_u8_marqueeStop == FALSE) && (gs_u16_marqueeCountdown > U8_ONE_VALUE))
+	{
+		gs_u16_marqueeCountdown--;
+	}
+	else if((gs_u8_busyFlagActive == TRUE) && (LCD_readBusyFlag(gs_ptr_str_queueConfig) == DIO_PIN_HIGH_LEVEL))
+	{
+		//controller still busy, retry on the next tick
+	}
+	else if((gs_u8_marqueeStop == TRUE) || (gs_u8_marqueeDone == TRUE))
+	{
+		/* return home also undoes the display shift */
+		LCD_transferByte(gs_ptr_str_queueConfig, LCD_CMD_CURSOR_HOME, DIO_PIN_LOW_LEVEL);
+		if(gs_u8_busyFlagActive == FALSE)
+		{
+			gs_u8_queueWaitTicks = LCD_QUEUE_LONG_CMD_TICKS;
 		}
-		ENABLE(ptr_str_config);
-		delay_3_ms();
+		gs_u8_marqueeActive = FALSE;
 	}
 	else
 	{
-		//do nothing
+		LCD_transferByte(gs_ptr_str_queueConfig, LCD_DISPLAY_SHIFT_LEFT, DIO_PIN_LOW_LEVEL);
+		if(gs_u8_marqueeStepsLeft != LCD_MARQUEE_ENDLESS)
+		{
+			gs_u8_marqueeStepsLeft--;
+			if(gs_u8_marqueeStepsLeft == U8_ZERO_VALUE)
+			{
+				/* the last position stays up for one period before the return home */
+				gs_u8_marqueeDone = TRUE;
+			}
+		}
+		gs_u16_marqueeCountdown = gs_u16_marqueePeriod;
 	}
 }
 
@@ -297,14 +1692,127 @@ static void ENABLE(lcd_str_config_t* ptr_str_config)
 {
 	
 	DIO_write_pin(ptr_str_config->str_Epin.enu_port, ptr_str_config->str_Epin.enu_pin, DIO_PIN_HIGH_LEVEL);
-	delay_3_ms();
+	DELAY_US(LCD_ENABLE_PULSE_US);
 	DIO_write_pin(ptr_str_config->str_Epin.enu_port, ptr_str_config->str_Epin.enu_pin, DIO_PIN_LOW_LEVEL);
 
 
 }
 
-void delay_3_ms(void){
-	static uint32_t u32_desired_ticks = 5000;
-	for(volatile uint32_t u32_counter = 0; u32_counter < u32_desired_ticks; u32_counter++);
-	
-}
\ No newline at end of file
+static void LCD_bargraphDrawCell(lcd_str_config_t *ptr_str_config, lcd_str_bargraph_t *ptr_str_bar, uint8_t copy_u8_cell)
+{
+	uint8_t u8_cell_start = copy_u8_cell * LCD_BAR_STEPS_PER_CELL;
+	uint8_t u8_code;
+	if(ptr_str_bar->u8_level >= (u8_cell_start + LCD_BAR_STEPS_PER_CELL))
+	{
+		u8_code = LCD_FULL_BLOCK_CHAR;
+	}
+	else if(ptr_str_bar->u8_level <= u8_cell_start)
+	{
+		u8_code = LCD_BLANK_CHAR;
+	}
+	else if(LCD_glyphAcquire(ptr_str_config, &gs_str_arr_barGlyph[ptr_str_bar->u8_level - u8_cell_start - U8_ONE_VALUE], &u8_code) != LCD_E_OK)
+	{
+		u8_code = LCD_BLANK_CHAR;
+	}
+	else
+	{
+		//partial cell, code from the glyph cache
+	}
+	LCD_shadowPut(ptr_str_bar->u8_row, ptr_str_bar->u8_col + copy_u8_cell, u8_code);
+}
+
+static void LCD_shadowPut(uint8_t copy_u8_row, uint8_t copy_u8_col, uint8_t copy_u8_data)
+{
+	if(gs_u8_arr_shadow[copy_u8_row][copy_u8_col] != copy_u8_data)
+	{
+		gs_u8_arr_shadow[copy_u8_row][copy_u8_col] = copy_u8_data;
+		gs_u16_arr_dirty[copy_u8_row] |= LCD_COL_BIT(copy_u8_col);
+	}
+}
+
+static void LCD_trackCommand(uint8_t copy_u8_cmd)
+{
+	/* the highest set bit selects the instruction */
+	if((copy_u8_cmd & LCD_INSTR_SET_DDRAM) != U8_ZERO_VALUE)
+	{
+		gs_u8_addressCounter = copy_u8_cmd;
+	}
+	else if((copy_u8_cmd & LCD_INSTR_SET_CGRAM) != U8_ZERO_VALUE)
+	{
+		/* data now goes to CGRAM */
+		gs_u8_addressCounter = LCD_ADDRESS_UNKNOWN;
+	}
+	else if((copy_u8_cmd & LCD_INSTR_FUNCTION_SET) != U8_ZERO_VALUE)
+	{
+		//address unchanged
+	}
+	else if((copy_u8_cmd & LCD_INSTR_SHIFT) != U8_ZERO_VALUE)
+	{
+		if((copy_u8_cmd & LCD_INSTR_SHIFT_DISPLAY) == U8_ZERO_VALUE)
+		{
+			/* a cursor shift moves the address counter, a display shift does not */
+			gs_u8_addressCounter = LCD_ADDRESS_UNKNOWN;
+		}
+	}
+	else if((copy_u8_cmd & LCD_INSTR_DISPLAY_CONTROL) != U8_ZERO_VALUE)
+	{
+		//address unchanged
+	}
+	else if((copy_u8_cmd & LCD_INSTR_ENTRY_MODE) != U8_ZERO_VALUE)
+	{
+		gs_u8_addressIncrement = ((copy_u8_cmd & LCD_INSTR_ENTRY_INCREMENT) != U8_ZERO_VALUE) ? TRUE : FALSE;
+	}
+	else if(copy_u8_cmd != U8_ZERO_VALUE)
+	{
+		/* clear and return home both go to the first cell; clear also selects increment */
+		gs_u8_addressCounter = LCD_DDRAM_START_ADD_LINE_1;
+		if(copy_u8_cmd == LCD_CMD_CLEAR)
+		{
+			gs_u8_addressIncrement = TRUE;
+		}
+	}
+	else
+	{
+		//no instruction
+	}
+}
+
+static void LCD_trackData(void)
+{
+	if(gs_u8_addressIncrement == FALSE)
+	{
+		gs_u8_addressCounter = LCD_ADDRESS_UNKNOWN;
+	}
+	else if(gs_u8_addressCounter != LCD_ADDRESS_UNKNOWN)
+	{
+		gs_u8_addressCounter++;
+		if((gs_u8_addressCounter & ~(LCD_INSTR_SET_DDRAM | LCD_DDRAM_LINE_SELECT)) == LCD_DDRAM_LINE_LENGTH)
+		{
+			/* the end of one line continues at the start of the other */
+			gs_u8_addressCounter = LCD_INSTR_SET_DDRAM | ((gs_u8_addressCounter & LCD_DDRAM_LINE_SELECT) ^ LCD_DDRAM_LINE_SELECT);
+		}
+	}
+	else
+	{
+		//still unknown
+	}
+}
+
+static uint8_t LCD_addressColumn(uint8_t copy_u8_row)
+{
+	uint8_t u8_col = (uint8_t)(gs_u8_addressCounter - gs_u8_arr_rowAddress[copy_u8_row]);
+	if((gs_u8_addressCounter == LCD_ADDRESS_UNKNOWN) || (u8_col >= LCD_COLS_MAX))
+	{
+		u8_col = LCD_COLS_MAX;
+	}
+	return u8_col;
+}
+
+static uint8_t LCD_nextDirty(uint8_t copy_u8_row, uint8_t copy_u8_col)
+{
+	while((copy_u8_col < LCD_COLS_MAX) && ((gs_u16_arr_dirty[copy_u8_row] & LCD_COL_BIT(copy_u8_col)) == U8_ZERO_VALUE))
+	{
+		copy_u8_col++;
+	}
+	return copy_u8_col;
+}
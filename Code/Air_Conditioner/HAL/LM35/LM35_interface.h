@@ -14,7 +14,22 @@
 #define LM35_INTERFACE_H_
 
 #include "../../MCAL/ADC/ADC_interface.h"
-#define	LM35_VOLT_PER_DEGREE 0.01
+#include "../../STD_LIB/FILTER/FILTER_interface.h"
+
+/**< Sensor output in millivolts per degree Celsius. */
+#define	LM35_MV_PER_DEGREE			10UL
+
+/**< Fractional bits of a temperature, readings are in Q8.8 degrees Celsius. */
+#define LM35_TEMP_FRAC_BITS			8
+
+/**< Shift applied after the multiply, it keeps the multiplier exact for the usual references. Oversampled codes shift by their extra bits more. */
+#define LM35_CODE_SHIFT				8
+
+/**< Multiplier from an ADC code to Q8.8 degrees before LM35_CODE_SHIFT, rounded, computed at compile time. */
+#define LM35_CODE_TO_TEMP_MUL		((uint32_t)((((ADC_EXTERNAL_VREF_MV << (LM35_TEMP_FRAC_BITS + LM35_CODE_SHIFT)) / LM35_MV_PER_DEGREE) + (ADC_CODE_COUNT / 2UL)) / ADC_CODE_COUNT))
+
+/**< Highest temperature a Q8.8 reading holds, hotter readings saturate to it. */
+#define LM35_TEMP_MAX				((sint16_t)0x7FFF)
 
 /**
  * @brief Enumeration for LM35 module return states.
@@ -40,6 +55,9 @@ typedef struct{
  */
 typedef struct{
     adc_str_config_t str_lm35_adc_config; /**< LM35 sensor ADC configuration. */
+    adc_enu_trigger_t enu_lm35_trigger;   /**< Event that starts each conversion of the background acquisition. */
+    filter_str_stage_t *ptr_str_filter;   /**< Filter chain every reading passes through in order, set up with FILTER_init, NULL for none. */
+    uint8_t u8_filter_stages;             /**< Number of stages in ptr_str_filter. */
 } lm35_str_config_t;
 	
 
@@ -47,7 +65,8 @@ typedef struct{
 /**
  * @brief Initialize the LM35 temperature sensor.
  *
- * Initializes the LM35 temperature sensor by configuring its associated ADC channel.
+ * Initializes the LM35 temperature sensor by configuring its associated ADC channel and starts the background
+ * acquisition of that channel. Only one sensor can be acquired at a time.
  *
  * @param[in] lm35_obj Pointer to the LM35 channel object.
  * @param[in] lm35_config Pointer to the LM35 configuration.
@@ -58,27 +77,29 @@ lm35_enu_return_state_t LM35_init(lm35_str_channel_t *lm35_obj, lm35_str_config_
 /**
  * @brief Read temperature from LM35 sensor.
  *
- * Reads the temperature from the LM35 sensor using the configured ADC channel and returns it in degrees Celsius.
+ * Converts the samples the background acquisition gathered since the last call to degrees Celsius, passes each
+ * through the filter chain of the configuration and returns the newest output, without waiting for a conversion.
+ * When no new sample has arrived since the last call the previous output is used again.
  *
  * @param[in] lm35_obj Pointer to the LM35 channel object.
  * @param[in] lm35_config Pointer to the LM35 configuration.
- * @param[out] temp Pointer to store the temperature value in degrees Celsius.
- * @return Status of the temperature reading operation.
+ * @param[out] temp Pointer to store the temperature in Q8.8 degrees Celsius, unchanged when no sample exists yet.
+ * @return Status of the temperature reading operation: LM35_OK, or LM35_NOK before the first sample.
  */
-lm35_enu_return_state_t LM35_read_temp(lm35_str_channel_t *lm35_obj, lm35_str_config_t *lm35_config, double *temp);
+lm35_enu_return_state_t LM35_read_temp(lm35_str_channel_t *lm35_obj, lm35_str_config_t *lm35_config, sint16_t *temp);
 
 /**
  * @brief Read temperature asynchronously using callback.
  *
  * Reads the temperature from the LM35 sensor asynchronously using callback functions.
- * The ADC reading is converted to temperature using a provided conversion function.
+ * The ADC code is converted in place to Q8.8 degrees Celsius before the data is handed on, so the reading
+ * reaches the caller through the conversion's data pointer once the conversion ends, not through this call.
  *
  * @param[in] lm35_obj Pointer to the LM35 channel object.
  * @param[in] lm35_config Pointer to the LM35 configuration.
- * @param[out] temp Pointer to store the temperature value in degrees Celsius.
  * @param[in] callback Callback function to initiate ADC conversion.
  * @return Status of the asynchronous temperature reading operation.
  */
-lm35_enu_return_state_t LM35_read_temp_INT(lm35_str_channel_t *lm35_obj, lm35_str_config_t *lm35_config, double *temp, void(*callback)(adc_str_config_t **ptr_ptr_str_adc_config, double **ptr_ptr_do_data));
+lm35_enu_return_state_t LM35_read_temp_INT(lm35_str_channel_t *lm35_obj, lm35_str_config_t *lm35_config, void(*callback)(adc_str_config_t **ptr_ptr_str_adc_config, uint16_t **ptr_ptr_u16_data));
 
 #endif /* LM35_H_ */
\ No newline at end of file
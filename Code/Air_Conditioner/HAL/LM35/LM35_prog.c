@@ -10,17 +10,38 @@
 
 #include "LM35_interface.h"
 
+/**< Newest filtered reading and whether one has arrived. */
+static sint16_t gs_s16_lastTemp = 0;
+static uint8_t gs_u8_haveTemp = FALSE;
+
+
+/**
+ * @brief Convert an ADC code to temperature with one multiply and one shift.
+ *
+ * @param[in] copy_u16_code ADC code.
+ * @param[in] copy_u8_extra_bits Bits the code has beyond ADC_BIT_RESOLUTION from oversampling.
+ * @return Temperature in Q8.8 degrees Celsius, saturated to LM35_TEMP_MAX.
+ */
+static sint16_t LM35_code_to_temp(uint16_t copy_u16_code, uint8_t copy_u8_extra_bits){
+	uint32_t u32_temp = ((uint32_t)copy_u16_code * LM35_CODE_TO_TEMP_MUL) >> (LM35_CODE_SHIFT + copy_u8_extra_bits);
+	sint16_t s16_temp = LM35_TEMP_MAX;
+	
+	if(u32_temp < (uint32_t)LM35_TEMP_MAX){
+		s16_temp = (sint16_t)u32_temp;
+	}
+	return s16_temp;
+}
 
 /**
  * @brief ADC callback function to convert ADC reading to temperature.
  *
- * This function converts the ADC reading to temperature in degrees Celsius.
+ * This function converts the ADC code in place to Q8.8 degrees Celsius.
  *
- * @param[in,out] data Pointer to the ADC reading (double) to be converted to temperature.
+ * @param[in,out] data Pointer to the ADC code (uint16_t) to be converted to temperature.
  */
 static void LM35_adc_to_temp(void *data){
 	
-	*((double*)data) = *((double*)data)/LM35_VOLT_PER_DEGREE;
+	*((sint16_t*)data) = LM35_code_to_temp(*((uint16_t*)data), 0);
 }
 
 lm35_enu_return_state_t LM35_init(lm35_str_channel_t *lm35_obj, lm35_str_config_t *lm35_config){
@@ -31,26 +52,47 @@ lm35_enu_return_state_t LM35_init(lm35_str_channel_t *lm35_obj, lm35_str_config_
 	else{
 		ADC_init(&(lm35_config->str_lm35_adc_config));
 		ADC_channel_init(&(lm35_obj->str_lm35_channel));	
+		gs_u8_haveTemp = FALSE;
+		if(ADC_acquisition_start(&(lm35_config->str_lm35_adc_config), &(lm35_obj->str_lm35_channel), lm35_config->enu_lm35_trigger) != ADC_OK){
+			enu_return_state = LM35_NOK;
+		}
 	}
 	return enu_return_state;
 }
 
-lm35_enu_return_state_t LM35_read_temp(lm35_str_channel_t *lm35_obj,lm35_str_config_t *lm35_config, double *temp){
+lm35_enu_return_state_t LM35_read_temp(lm35_str_channel_t *lm35_obj,lm35_str_config_t *lm35_config, sint16_t *temp){
 	lm35_enu_return_state_t enu_return_state = LM35_OK;
-	double data = 0;
-	if((lm35_obj == NULL) || (lm35_config == NULL)){
+	uint16_t u16_arr_codes[ADC_ACQ_RING_SIZE];
+	uint8_t u8_count = 0;
+	uint8_t u8_index;
+	sint16_t s16_temp;
+	if((lm35_obj == NULL) || (lm35_config == NULL) || (temp == NULL)){
 		enu_return_state =LM35_NOK;
 	}
 	else{
+		/* empty the ring in one batch, every sample goes through the filter so none of its history is skipped */
+		if(ADC_acquisition_read(u16_arr_codes, ADC_ACQ_RING_SIZE, &u8_count) == ADC_OK){
+			for(u8_index = 0; u8_index < u8_count; u8_index++){
+				s16_temp = LM35_code_to_temp(u16_arr_codes[u8_index], lm35_config->str_lm35_adc_config.u8_oversample_bits);
+				if(lm35_config->ptr_str_filter != NULL){
+					FILTER_chainRun(lm35_config->ptr_str_filter, lm35_config->u8_filter_stages, s16_temp, &s16_temp);
+				}
+				gs_s16_lastTemp = s16_temp;
+			}
+			gs_u8_haveTemp = TRUE;
+		}
 		
-		ADC_channel_read(&(lm35_config->str_lm35_adc_config), &(lm35_obj->str_lm35_channel), &data);
-		*temp = data/LM35_VOLT_PER_DEGREE;
+		if(gs_u8_haveTemp == TRUE){
+			*temp = gs_s16_lastTemp;
+		}else{
+			enu_return_state = LM35_NOK;
+		}
 	}
 	return enu_return_state;
 	
 }
 
-lm35_enu_return_state_t LM35_read_temp_INT(lm35_str_channel_t *lm35_obj, lm35_str_config_t *lm35_config, double *temp, void(*callback)(adc_str_config_t **ptr_ptr_str_adc_config, double **ptr_ptr_do_data)){
+lm35_enu_return_state_t LM35_read_temp_INT(lm35_str_channel_t *lm35_obj, lm35_str_config_t *lm35_config, void(*callback)(adc_str_config_t **ptr_ptr_str_adc_config, uint16_t **ptr_ptr_u16_data)){
 	lm35_enu_return_state_t enu_return_state = LM35_OK;
 	if(lm35_obj == NULL){
 		enu_return_state =LM35_NOK;
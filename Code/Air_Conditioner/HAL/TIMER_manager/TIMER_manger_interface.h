@@ -105,4 +105,17 @@ timerm_enu_return_state_t TIMER_MANGER_stop(const timer_enu_timer_number_t copy_
  */
 timerm_enu_return_state_t TIMER_MANGER_setValue(const timer_enu_timer_number_t copy_enu_timer_num , uint16_t copy_u16_InitialValue);
 
+/**
+ * @brief Read the current count of a timer using the Timer Manager module.
+ *
+ * This function reads the counting register of a specified timer without stopping it.
+ *
+ * @param copy_enu_timer_num The timer number to read.
+ * @param ptr_u16_value Pointer to store the count.
+ * @return The return state of reading the timer's value.
+ *     - #TIMERM_E_OK: Timer value read successfully.
+ *     - #TIMERM_E_NOK: Timer value read failed.
+ */
+timerm_enu_return_state_t TIMER_MANGER_getValue(const timer_enu_timer_number_t copy_enu_timer_num , uint16_t *ptr_u16_value);
+
 #endif /* TIMER_MANGER_H_ */
\ No newline at end of file
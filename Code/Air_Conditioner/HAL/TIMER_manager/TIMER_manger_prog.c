@@ -84,4 +84,22 @@ timerm_enu_return_state_t TIMER_MANGER_setValue(const timer_enu_timer_number_t c
 		l_ret =  TIMERx_setValue(copy_enu_timer_num , u16_a_InitialValue);
 	}
 	return l_ret;
-}
\ No newline at end of file
+}
+
+timerm_enu_return_state_t TIMER_MANGER_getValue(const timer_enu_timer_number_t copy_enu_timer_num , uint16_t *ptr_u16_value)
+{
+	timerm_enu_return_state_t l_ret = TIMERM_E_OK;
+	if((copy_enu_timer_num >= INVALID_TIMER_TYPE) || (ptr_u16_value == NULL))
+	{
+		l_ret = TIMERM_E_NOK;
+	}
+	else if(TIMERx_getValue(copy_enu_timer_num , ptr_u16_value) != TIMER_OK)
+	{
+		l_ret = TIMERM_E_NOK;
+	}
+	else
+	{
+		/*count read while the timer runs*/
+	}
+	return l_ret;
+}
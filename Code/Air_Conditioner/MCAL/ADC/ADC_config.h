@@ -18,6 +18,15 @@
  /**< ADC external reference voltage in volts. */
 #define ADC_EXTERNAL_VREF_VOLT		5
 
+/**< Samples held by the acquisition ring (power of 2, at most 128). */
+#define ADC_ACQ_RING_SIZE			16
+
+/**< Most channels in the scan table (1 to 8, one per PORTA input). */
+#define ADC_SCAN_MAX_CHANNELS		8
+
+/**< Conversions thrown away after the scan switches channel, while the sample-and-hold settles (0 to 3). */
+#define ADC_SCAN_SETTLE_DISCARD		1
+
 
 
 #endif /* ADC_CONFIG_H_ */
\ No newline at end of file
@@ -21,6 +21,30 @@
 #error ADC external vref
 #endif
 
+#if (ADC_ACQ_RING_SIZE < 2) || (ADC_ACQ_RING_SIZE > 128) || ((ADC_ACQ_RING_SIZE & (ADC_ACQ_RING_SIZE - 1)) != 0)
+#error ADC acquisition ring size, a power of 2 from 2 to 128
+#endif
+
+#if (ADC_SCAN_MAX_CHANNELS < 1) || (ADC_SCAN_MAX_CHANNELS > 8)
+#error ADC scan channels, 1 to 8
+#endif
+
+#if (ADC_SCAN_SETTLE_DISCARD < 0) || (ADC_SCAN_SETTLE_DISCARD > 3)
+#error ADC scan settle discard, 0 to 3
+#endif
+
+/**< Number of codes of a conversion. */
+#define ADC_CODE_COUNT			(1UL << ADC_BIT_RESOLUTION)
+
+/**< External reference voltage in millivolts, for integer conversions of the codes. */
+#define ADC_EXTERNAL_VREF_MV	((uint32_t)ADC_EXTERNAL_VREF_VOLT * 1000UL)
+
+/**< Index mask of the acquisition ring. */
+#define ADC_ACQ_RING_MASK		(ADC_ACQ_RING_SIZE - 1)
+
+/**< Most extra bits of the acquisition by oversampling, the sum of 4^3 codes still fits 16 bits. */
+#define ADC_OVERSAMPLE_BITS_MAX	3
+
 /**
  * @brief Enumeration for ADC data adjustment selection.
  */
@@ -61,6 +85,21 @@ typedef enum{
     ADC_INTERRUPT_ENABLE     /**< ADC interrupt enabled. */
 } adc_enu_interrupt_t;
 
+/**
+ * @brief Enumeration for the event that starts each conversion of the acquisition.
+ */
+typedef enum{
+    ADC_TRIGGER_FREE_RUNNING=0,       /**< Each conversion starts when the last one ends. */
+    ADC_TRIGGER_ANALOG_COMPARATOR,    /**< Analog comparator output edge. */
+    ADC_TRIGGER_EXT_INT_0,            /**< External interrupt 0 request. */
+    ADC_TRIGGER_TIMER0_COMPARE,       /**< Timer 0 compare match. */
+    ADC_TRIGGER_TIMER0_OVERFLOW,      /**< Timer 0 overflow. */
+    ADC_TRIGGER_TIMER1_COMPARE_B,     /**< Timer 1 compare match B. */
+    ADC_TRIGGER_TIMER1_OVERFLOW,      /**< Timer 1 overflow. */
+    ADC_TRIGGER_TIMER1_CAPTURE,       /**< Timer 1 input capture. */
+    ADC_TRIGGER_INVALID               /**< Number of triggers. */
+}adc_enu_trigger_t;
+
 /**
  * @brief Enumeration for ADC module return states.
  */
@@ -68,7 +107,12 @@ typedef enum{
     ADC_OK,                /**< Operation successful. */
     ADC_INVALID_PIN,       /**< Invalid pin. */
     ADC_INVALID_PORT,      /**< Invalid port. */
-    ADC_NULL_PTR           /**< Null pointer encountered. */
+    ADC_NULL_PTR,          /**< Null pointer encountered. */
+    ADC_INVALID_TRIGGER,   /**< Invalid acquisition trigger. */
+    ADC_BUSY,              /**< The acquisition owns the converter. */
+    ADC_NO_DATA,           /**< No sample available. */
+    ADC_INVALID_OVERSAMPLING, /**< Too many oversampling bits. */
+    ADC_INVALID_SCAN       /**< Empty or too long scan table, or a slot outside it. */
 } adc_enu_return_state_t;
 
 /**
@@ -79,6 +123,7 @@ typedef struct{
     adc_enu_vref_t adc_enu_vref;             /**< ADC voltage reference configuration. */
     adc_enu_interrupt_t adc_enu_interrupt;   /**< ADC interrupt configuration. */
     adc_enu_DATA_L_R_t adc_enu_DATA_L_R;     /**< ADC data adjustment configuration. */
+    uint8_t u8_oversample_bits;              /**< Extra bits of the acquisition, 0 to ADC_OVERSAMPLE_BITS_MAX: each sample is the sum of 4^n conversions shifted right by n. */
 } adc_str_config_t;
 
 
@@ -117,20 +162,20 @@ adc_enu_return_state_t ADC_channel_init(adc_str_channel_config_t *adc_channel_co
 /**
  * @brief Read ADC channel.
  *
- * Reads the value from an ADC channel and converts it to voltage.
+ * Reads the raw code of one conversion of an ADC channel, the caller scales it with integer constants.
  *
  * @param[in] adc_config Pointer to the ADC configuration.
  * @param[in] adc_channel_config Pointer to the ADC channel configuration.
- * @param[out] data Pointer to store the converted voltage.
+ * @param[out] data Pointer to store the code, 0 to ADC_CODE_COUNT - 1.
  * @return Status of the channel reading operation.
  */
-adc_enu_return_state_t ADC_channel_read(adc_str_config_t *adc_config, adc_str_channel_config_t *adc_channel_config, double *data);
+adc_enu_return_state_t ADC_channel_read(adc_str_config_t *adc_config, adc_str_channel_config_t *adc_channel_config, uint16_t *data);
 
 
 /**
  * @brief Read ADC channel asynchronously using callback.
  *
- * Reads the value from an ADC channel asynchronously using callback functions.
+ * Reads the raw code of an ADC channel asynchronously using callback functions.
  *
  * @param[in] adc_config Pointer to the ADC configuration.
  * @param[in] adc_channel_config Pointer to the ADC channel configuration.
@@ -138,7 +183,102 @@ adc_enu_return_state_t ADC_channel_read(adc_str_config_t *adc_config, adc_str_ch
  * @param[in] adc_end_ISR_func Callback function to handle ADC conversion completion.
  * @return Status of the asynchronous channel reading operation.
  */
-adc_enu_return_state_t ADC_channel_read_INT(adc_str_config_t *adc_config, adc_str_channel_config_t *adc_channel_config, void(*callback)(adc_str_config_t **adc_config, double **data), void(*adc_end_ISR)(void *data));
+adc_enu_return_state_t ADC_channel_read_INT(adc_str_config_t *adc_config, adc_str_channel_config_t *adc_channel_config, void(*callback)(adc_str_config_t **adc_config, uint16_t **data), void(*adc_end_ISR)(void *data));
+
+/**
+ * @brief Start the background acquisition of a channel.
+ *
+ * Conversions run back to back or on each trigger event, and the ADC interrupt stores every raw right-adjusted
+ * code in a ring of ADC_ACQ_RING_SIZE samples. With u8_oversample_bits = n the interrupt sums 4^n codes and stores
+ * the sum shifted right by n, a sample of ADC_BIT_RESOLUTION + n bits at 1/4^n of the conversion rate; the extra
+ * bits are real only when the input carries about one code of noise, which the LM35 and its wiring supply. When
+ * the ring is full new samples are dropped and counted. A timer trigger only restarts once the timer's own
+ * interrupt has cleared its flag. While the acquisition runs ADC_channel_read() and ADC_channel_read_INT() return
+ * ADC_BUSY, and it cannot start while a scan runs.
+ *
+ * @param[in] ptr_str_adc_config Pointer to the ADC configuration, its data adjustment and interrupt fields are not used.
+ * @param[in] ptr_str_channel_config Pointer to the ADC channel configuration.
+ * @param[in] copy_enu_trigger Event that starts each conversion.
+ * @return Status: ADC_OK if started, ADC_NULL_PTR, ADC_INVALID_PORT, ADC_INVALID_PIN, ADC_INVALID_TRIGGER,
+ *         ADC_INVALID_OVERSAMPLING or ADC_BUSY if a scan runs.
+ */
+adc_enu_return_state_t ADC_acquisition_start(adc_str_config_t *ptr_str_adc_config, adc_str_channel_config_t *ptr_str_channel_config, adc_enu_trigger_t copy_enu_trigger);
+
+/**
+ * @brief Stop the background acquisition.
+ *
+ * Samples already in the ring can still be read.
+ *
+ * @return Status: ADC_OK.
+ */
+adc_enu_return_state_t ADC_acquisition_stop(void);
+
+/**
+ * @brief Take the oldest samples out of the acquisition ring without waiting.
+ *
+ * @param[out] ptr_u16_codes Array to store the samples, oldest first, ADC_BIT_RESOLUTION + u8_oversample_bits bits each.
+ * @param[in] copy_u8_max Size of the array.
+ * @param[out] ptr_u8_count Pointer to store the number of codes stored.
+ * @return Status: ADC_OK if at least one code was read, ADC_NO_DATA if the ring is empty, ADC_NULL_PTR if NULL pointer provided.
+ */
+adc_enu_return_state_t ADC_acquisition_read(uint16_t *ptr_u16_codes, uint8_t copy_u8_max, uint8_t *ptr_u8_count);
+
+/**
+ * @brief Get the number of samples waiting in the acquisition ring.
+ *
+ * @param[out] ptr_u8_count Pointer to store the number of samples.
+ * @return Status: ADC_OK if successful, ADC_NULL_PTR if NULL pointer provided.
+ */
+adc_enu_return_state_t ADC_acquisition_available(uint8_t *ptr_u8_count);
+
+/**
+ * @brief Get the number of samples dropped because the ring was full.
+ *
+ * @param[out] ptr_u16_overruns Pointer to store the count, it saturates at 0xFFFF.
+ * @return Status: ADC_OK if successful, ADC_NULL_PTR if NULL pointer provided.
+ */
+adc_enu_return_state_t ADC_acquisition_overruns(uint16_t *ptr_u16_overruns);
+
+/**
+ * @brief Start the background scan of a table of channels.
+ *
+ * The ADC interrupt visits the channels in table order, round and round. On each visit it switches the
+ * multiplexer, throws away ADC_SCAN_SETTLE_DISCARD conversions while the input settles, then takes 4^n conversions
+ * with n = u8_oversample_bits and keeps their sum shifted right by n as the newest sample of that slot. Each
+ * conversion is started by the interrupt of the one before, so the channel switch never races a running
+ * conversion. The table is copied, it need not outlive the call. While the scan runs ADC_channel_read() and
+ * ADC_channel_read_INT() return ADC_BUSY, and it cannot start while the acquisition runs.
+ *
+ * @param[in] ptr_str_adc_config Pointer to the ADC configuration, its data adjustment and interrupt fields are not used.
+ * @param[in] ptr_str_arr_channels Channel table, slot i is entry i.
+ * @param[in] copy_u8_count Number of entries, 1 to ADC_SCAN_MAX_CHANNELS.
+ * @return Status: ADC_OK if started, ADC_NULL_PTR, ADC_INVALID_SCAN, ADC_INVALID_PORT, ADC_INVALID_PIN,
+ *         ADC_INVALID_OVERSAMPLING or ADC_BUSY if the acquisition runs.
+ */
+adc_enu_return_state_t ADC_scan_start(adc_str_config_t *ptr_str_adc_config, adc_str_channel_config_t *ptr_str_arr_channels, uint8_t copy_u8_count);
+
+/**
+ * @brief Stop the background scan after the conversion in progress.
+ *
+ * The newest sample of every slot can still be read.
+ *
+ * @return Status: ADC_OK.
+ */
+adc_enu_return_state_t ADC_scan_stop(void);
+
+/**
+ * @brief Read the newest sample of a scan slot without waiting.
+ *
+ * The sequence number goes up by one with every new sample of the slot and skips 0, so a consumer that keeps the
+ * last one it saw knows whether the sample is new and how many it missed.
+ *
+ * @param[in] copy_u8_slot Slot of the channel, its index in the scan table.
+ * @param[out] ptr_u16_code Pointer to store the sample, ADC_BIT_RESOLUTION + u8_oversample_bits bits.
+ * @param[out] ptr_u8_sequence Pointer to store the sequence number of the sample.
+ * @return Status: ADC_OK if a sample was read, ADC_NO_DATA before the first sample of the slot, ADC_INVALID_SCAN
+ *         for a slot outside the table, ADC_NULL_PTR if NULL pointer provided.
+ */
+adc_enu_return_state_t ADC_scan_read(uint8_t copy_u8_slot, uint16_t *ptr_u16_code, uint8_t *ptr_u8_sequence);
 
 
 
@@ -25,6 +25,7 @@
 #define ADCSRA_ADD	(*((volatile uint8_t *)0x26))
 #define ADC_ENABLE	7
 #define ADC_START_CONVERSION	6
+#define ADC_AUTO_TRIGGER_ENABLE	5
 #define ADC_INT_FLAG	4
 #define ADC_INT_ENABLE	3
 
@@ -33,15 +34,19 @@
 #define ADCL_ADD	(*((volatile uint8_t *)0x24))
 
 
+#define SFIOR_ADD	(*((volatile uint8_t *)0x50))
+#define ADC_AUTO_TRIGGER_SOURCE	5
+
+
 #define ADC_ADCH	(*((volatile uint8_t *)0x25))
 #define ADC_ADCL	(*((volatile uint8_t *)0x24))
 
 
 #define ADC_ADMUX_MASK					((uint8_t)0xE0)
+#define ADC_SFIOR_MASK					((uint8_t)0x1F)
 #define ADC_SHIFT_BY_8					((uint8_t)8)
 #define ADC_SHIFT_BY_6					((uint8_t)6)
 #define ADC_SHIFT_BY_2					((uint8_t)2)
-#define ADC_START_VALUE_OF_REGISTER		((uint8_t)2)
 
 
 #endif
\ No newline at end of file
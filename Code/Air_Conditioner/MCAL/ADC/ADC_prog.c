@@ -2,7 +2,10 @@
  * @file ADC_prog.c
  * @brief ADC module implementation.
  *
- * This file contains the implementation of the ADC module functions.
+ * This file contains the implementation of the ADC module functions. The background acquisition stores the
+ * codes from the ADC interrupt in a single-producer single-consumer ring: the head is written only by the
+ * interrupt and the tail only by the reader, so neither side disables interrupts. The scan keeps one newest
+ * sample per channel instead, published by a sequence number written after the sample.
  *
  * @date 4/21/2023
  * @author Arafa Arafa
@@ -13,28 +16,65 @@
 #include "ADC_interface.h"
 #include "../AVR_ARCH/ISR_interface.h"
 
-/**< Quantisation step value for ADC conversion. */
-static double Quantisation_step; 
-
 /**< Callback function for ADC conversion. */
-static void(*callback_ISR)(adc_str_config_t **adc_config, double **data); 
+static void(*callback_ISR)(adc_str_config_t **adc_config, uint16_t **data); 
 
 /**< Callback function for ADC conversion completion. */
 static void(*adc_end_ISR)(void *data);
 
+/**< TRUE while the background acquisition owns the converter. */
+static volatile uint8_t gs_u8_acqRunning = FALSE;
+
+/**< Acquisition ring: the head is written only by the ADC interrupt, the tail only by the reader. */
+static volatile uint16_t gs_u16_arr_acqRing[ADC_ACQ_RING_SIZE];
+static volatile uint8_t gs_u8_acqHead = U8_ZERO_VALUE;
+static volatile uint8_t gs_u8_acqTail = U8_ZERO_VALUE;
+
+/**< Samples dropped on a full ring, written only by the ADC interrupt. */
+static volatile uint16_t gs_u16_acqOverruns = U8_ZERO_VALUE;
+
+/**< Oversampling of the acquisition: extra bits, codes per sample, and the sum and count of the sample being built. */
+static uint8_t gs_u8_acqOversampleBits = U8_ZERO_VALUE;
+static uint8_t gs_u8_acqSumTarget = U8_ONE_VALUE;
+static uint16_t gs_u16_acqSum = U8_ZERO_VALUE;
+static uint8_t gs_u8_acqSumCount = U8_ZERO_VALUE;
+
+/**< TRUE while the scan owns the converter. */
+static volatile uint8_t gs_u8_scanRunning = FALSE;
+
+/**< Scan table: multiplexer input of each slot and number of slots. */
+static uint8_t gs_u8_arr_scanPins[ADC_SCAN_MAX_CHANNELS];
+static uint8_t gs_u8_scanCount = U8_ZERO_VALUE;
+
+/**< Newest sample of each slot and its sequence number, written only by the ADC interrupt, the sample first. */
+static volatile uint16_t gs_u16_arr_scanValues[ADC_SCAN_MAX_CHANNELS];
+static volatile uint8_t gs_u8_arr_scanSequences[ADC_SCAN_MAX_CHANNELS];
+
+/**< Scan position: slot being converted, conversions left to discard, and the oversampling of its sample. */
+static uint8_t gs_u8_scanSlot = U8_ZERO_VALUE;
+static uint8_t gs_u8_scanDiscard = U8_ZERO_VALUE;
+static uint8_t gs_u8_scanOversampleBits = U8_ZERO_VALUE;
+static uint8_t gs_u8_scanSumTarget = U8_ONE_VALUE;
+static uint16_t gs_u16_scanSum = U8_ZERO_VALUE;
+static uint8_t gs_u8_scanSumCount = U8_ZERO_VALUE;
+
+/**
+ * @brief Store the code of the finished conversion in the acquisition ring.
+ */
+static void ADC_acquisition_push(void);
+
+/**
+ * @brief Take the code of the finished conversion into the scan, move to the next slot when its sample is
+ *        complete and start the next conversion.
+ */
+static void ADC_scan_step(void);
+
 adc_enu_return_state_t ADC_init(adc_str_config_t *adc_config){
 	adc_enu_return_state_t enu_return_state = ADC_OK;
 	if(adc_config != NULL){
 		
 		ADCSRA_ADD =	(1<<ADC_ENABLE)|(adc_config->adc_enu_prescaler)|(adc_config->adc_enu_interrupt<<ADC_INT_ENABLE);
-		ADMUX_ADD =	 (adc_config->adc_enu_vref<<ADC_VREF_SELECT) | (adc_config->adc_enu_interrupt<<ADC_LEFT_ADJUST_RESULT);
-		uint16_t result = ADC_START_VALUE_OF_REGISTER;
-		for(int i= U8_ONE_VALUE; i<ADC_BIT_RESOLUTION;i++){
-			result *= ADC_START_VALUE_OF_REGISTER;
-			
-		}
-		Quantisation_step= ((double)ADC_EXTERNAL_VREF_VOLT)/(result);
-		
+		ADMUX_ADD =	 (adc_config->adc_enu_vref<<ADC_VREF_SELECT) | (adc_config->adc_enu_DATA_L_R<<ADC_LEFT_ADJUST_RESULT);
 	}
 	else{
 		enu_return_state = ADC_NULL_PTR;
@@ -60,12 +100,16 @@ adc_enu_return_state_t ADC_channel_init(adc_str_channel_config_t *adc_channel_co
 	return enu_return_state; 
 }
 
-adc_enu_return_state_t ADC_channel_read(adc_str_config_t *adc_config, adc_str_channel_config_t *adc_channel_config, double *data){
+adc_enu_return_state_t ADC_channel_read(adc_str_config_t *adc_config, adc_str_channel_config_t *adc_channel_config, uint16_t *data){
 	adc_enu_return_state_t enu_return_state = ADC_OK;
-	if( (adc_channel_config != NULL) || (data != NULL) || (adc_config != NULL)){
-		if(adc_channel_config->enu_channel_port == PORTA){
+	if( (adc_channel_config != NULL) && (data != NULL) && (adc_config != NULL)){
+		if((gs_u8_acqRunning == TRUE) || (gs_u8_scanRunning == TRUE)){
+			enu_return_state = ADC_BUSY;
+		}else if(adc_channel_config->enu_channel_port == PORTA){
 			while(READ_BIT(ADCSRA_ADD, ADC_START_CONVERSION) == U8_ONE_VALUE);
 			ADMUX_ADD  = (ADC_ADMUX_MASK & ADMUX_ADD) | adc_channel_config->enu_channel_pin;
+			/* the flag of an earlier conversion is still set, writing 1 clears it so the wait below sees this one */
+			SET_BIT(ADCSRA_ADD, ADC_INT_FLAG);
 			SET_BIT(ADCSRA_ADD, ADC_START_CONVERSION);
 			while(READ_BIT(ADCSRA_ADD, ADC_INT_FLAG) == U8_ZERO_VALUE);
 			uint16_t adc_data_temp= U8_ZERO_VALUE;
@@ -77,7 +121,7 @@ adc_enu_return_state_t ADC_channel_read(adc_str_config_t *adc_config, adc_str_ch
 				adc_data_temp |=(ADCH_ADD<<ADC_SHIFT_BY_2);
 			}
 			
-			*data = Quantisation_step*adc_data_temp;
+			*data = adc_data_temp;
 		}else{
 			enu_return_state = ADC_INVALID_PORT;
 		}
@@ -90,10 +134,12 @@ adc_enu_return_state_t ADC_channel_read(adc_str_config_t *adc_config, adc_str_ch
 }
 
 
-adc_enu_return_state_t ADC_channel_read_INT(adc_str_config_t *adc_config, adc_str_channel_config_t *adc_channel_config, void(*callback)(adc_str_config_t **adc_config, double **data), void(*adc_end_ISR_func)(void *data)){
+adc_enu_return_state_t ADC_channel_read_INT(adc_str_config_t *adc_config, adc_str_channel_config_t *adc_channel_config, void(*callback)(adc_str_config_t **adc_config, uint16_t **data), void(*adc_end_ISR_func)(void *data)){
 	adc_enu_return_state_t enu_return_state = ADC_OK;
-	if(adc_channel_config == NULL || adc_channel_config->enu_channel_port != PORTA || callback == NULL){
-		if(adc_channel_config->enu_channel_port != PORTA){
+	if((adc_channel_config != NULL) && (adc_config != NULL) && (callback != NULL)){
+		if((gs_u8_acqRunning == TRUE) || (gs_u8_scanRunning == TRUE)){
+			enu_return_state = ADC_BUSY;
+		}else if(adc_channel_config->enu_channel_port == PORTA){
 			while(READ_BIT(ADCSRA_ADD, ADC_START_CONVERSION) == U8_ONE_VALUE);
 			callback_ISR = callback;
 			adc_end_ISR = adc_end_ISR_func;
@@ -112,7 +158,7 @@ adc_enu_return_state_t ADC_channel_read_INT(adc_str_config_t *adc_config, adc_st
 	
 	return enu_return_state;
 }
-static void ADC_channel_read_ISR(adc_str_config_t	**adc_config, double **data){
+static void ADC_channel_read_ISR(adc_str_config_t	**adc_config, uint16_t **data){
 		uint16_t adc_data_temp = U8_ZERO_VALUE;
 		CLEAR_BIT(ADCSRA_ADD, ADC_INT_ENABLE);
 		if((*adc_config)->adc_enu_DATA_L_R == ADC_DATA_ADJUST_RIGHT){
@@ -123,20 +169,290 @@ static void ADC_channel_read_ISR(adc_str_config_t	**adc_config, double **data){
 			adc_data_temp = (ADCL_ADD>>ADC_SHIFT_BY_6);
 			adc_data_temp |=(ADCH_ADD<<ADC_SHIFT_BY_2);
 		}
-		**data = Quantisation_step*adc_data_temp;
+		**data = adc_data_temp;
+	
+}
+
+
+adc_enu_return_state_t ADC_acquisition_start(adc_str_config_t *ptr_str_adc_config, adc_str_channel_config_t *ptr_str_channel_config, adc_enu_trigger_t copy_enu_trigger){
+	adc_enu_return_state_t enu_return_state = ADC_OK;
+	
+	if((ptr_str_adc_config == NULL) || (ptr_str_channel_config == NULL)){
+		enu_return_state = ADC_NULL_PTR;
+	}else if(ptr_str_channel_config->enu_channel_port != PORTA){
+		enu_return_state = ADC_INVALID_PORT;
+	}else if(ptr_str_channel_config->enu_channel_pin > PIN7){
+		enu_return_state = ADC_INVALID_PIN;
+	}else if(copy_enu_trigger >= ADC_TRIGGER_INVALID){
+		enu_return_state = ADC_INVALID_TRIGGER;
+	}else if(ptr_str_adc_config->u8_oversample_bits > ADC_OVERSAMPLE_BITS_MAX){
+		enu_return_state = ADC_INVALID_OVERSAMPLING;
+	}else if(gs_u8_scanRunning == TRUE){
+		enu_return_state = ADC_BUSY;
+	}else{
+		/* stop the converter interrupt before the ring is emptied under it */
+		CLEAR_BIT(ADCSRA_ADD, ADC_INT_ENABLE);
+		CLEAR_BIT(ADCSRA_ADD, ADC_AUTO_TRIGGER_ENABLE);
+		gs_u8_acqHead = U8_ZERO_VALUE;
+		gs_u8_acqTail = U8_ZERO_VALUE;
+		gs_u16_acqOverruns = U8_ZERO_VALUE;
+		gs_u8_acqOversampleBits = ptr_str_adc_config->u8_oversample_bits;
+		gs_u8_acqSumTarget = (uint8_t)(U8_ONE_VALUE << (gs_u8_acqOversampleBits * ADC_SHIFT_BY_2));
+		gs_u16_acqSum = U8_ZERO_VALUE;
+		gs_u8_acqSumCount = U8_ZERO_VALUE;
+		callback_ISR = NULL;
+		adc_end_ISR = NULL;
+		
+		/* right-adjusted codes, the interrupt reads ADCL before ADCH */
+		ADMUX_ADD = (ptr_str_adc_config->adc_enu_vref << ADC_VREF_SELECT) | ptr_str_channel_config->enu_channel_pin;
+		SFIOR_ADD = (SFIOR_ADD & ADC_SFIOR_MASK) | (copy_enu_trigger << ADC_AUTO_TRIGGER_SOURCE);
+		gs_u8_acqRunning = TRUE;
+		/* writing the flag clears a result left by an earlier conversion */
+		ADCSRA_ADD = (1<<ADC_ENABLE) | (1<<ADC_AUTO_TRIGGER_ENABLE) | (1<<ADC_INT_FLAG) | (1<<ADC_INT_ENABLE) | ptr_str_adc_config->adc_enu_prescaler;
+		if(copy_enu_trigger == ADC_TRIGGER_FREE_RUNNING){
+			SET_BIT(ADCSRA_ADD, ADC_START_CONVERSION);
+		}else{
+			//the first trigger event starts the first conversion
+		}
+		sei();
+	}
+	return enu_return_state;
+}
+
+adc_enu_return_state_t ADC_acquisition_stop(void){
+	CLEAR_BIT(ADCSRA_ADD, ADC_AUTO_TRIGGER_ENABLE);
+	CLEAR_BIT(ADCSRA_ADD, ADC_INT_ENABLE);
+	gs_u8_acqRunning = FALSE;
+	return ADC_OK;
+}
+
+adc_enu_return_state_t ADC_acquisition_read(uint16_t *ptr_u16_codes, uint8_t copy_u8_max, uint8_t *ptr_u8_count){
+	adc_enu_return_state_t enu_return_state = ADC_OK;
+	uint8_t u8_count = U8_ZERO_VALUE;
+	uint8_t u8_tail = gs_u8_acqTail;
+	uint8_t u8_head = gs_u8_acqHead;
 	
+	if((ptr_u16_codes == NULL) || (ptr_u8_count == NULL)){
+		enu_return_state = ADC_NULL_PTR;
+	}else{
+		/* the samples up to the head seen here are complete, later ones wait for the next call */
+		while((u8_count < copy_u8_max) && (u8_tail != u8_head)){
+			ptr_u16_codes[u8_count] = gs_u16_arr_acqRing[u8_tail];
+			u8_tail = (u8_tail + U8_ONE_VALUE) & ADC_ACQ_RING_MASK;
+			u8_count++;
+		}
+		/* the slots go back to the interrupt only after they have been read */
+		gs_u8_acqTail = u8_tail;
+		*ptr_u8_count = u8_count;
+		if(u8_count == U8_ZERO_VALUE){
+			enu_return_state = ADC_NO_DATA;
+		}else{
+			//samples read
+		}
+	}
+	return enu_return_state;
+}
+
+adc_enu_return_state_t ADC_acquisition_available(uint8_t *ptr_u8_count){
+	adc_enu_return_state_t enu_return_state = ADC_OK;
+	
+	if(ptr_u8_count == NULL){
+		enu_return_state = ADC_NULL_PTR;
+	}else{
+		*ptr_u8_count = (gs_u8_acqHead - gs_u8_acqTail) & ADC_ACQ_RING_MASK;
+	}
+	return enu_return_state;
+}
+
+adc_enu_return_state_t ADC_acquisition_overruns(uint16_t *ptr_u16_overruns){
+	adc_enu_return_state_t enu_return_state = ADC_OK;
+	uint16_t u16_overruns;
+	
+	if(ptr_u16_overruns == NULL){
+		enu_return_state = ADC_NULL_PTR;
+	}else{
+		/* read again if a conversion ended between the two bytes */
+		do{
+			u16_overruns = gs_u16_acqOverruns;
+		}while(u16_overruns != gs_u16_acqOverruns);
+		*ptr_u16_overruns = u16_overruns;
+	}
+	return enu_return_state;
+}
+
+adc_enu_return_state_t ADC_scan_start(adc_str_config_t *ptr_str_adc_config, adc_str_channel_config_t *ptr_str_arr_channels, uint8_t copy_u8_count){
+	adc_enu_return_state_t enu_return_state = ADC_OK;
+	uint8_t u8_slot;
+	
+	if((ptr_str_adc_config == NULL) || (ptr_str_arr_channels == NULL)){
+		enu_return_state = ADC_NULL_PTR;
+	}else if((copy_u8_count == U8_ZERO_VALUE) || (copy_u8_count > ADC_SCAN_MAX_CHANNELS)){
+		enu_return_state = ADC_INVALID_SCAN;
+	}else if(ptr_str_adc_config->u8_oversample_bits > ADC_OVERSAMPLE_BITS_MAX){
+		enu_return_state = ADC_INVALID_OVERSAMPLING;
+	}else if(gs_u8_acqRunning == TRUE){
+		enu_return_state = ADC_BUSY;
+	}else{
+		for(u8_slot = U8_ZERO_VALUE; (u8_slot < copy_u8_count) && (enu_return_state == ADC_OK); u8_slot++){
+			if(ptr_str_arr_channels[u8_slot].enu_channel_port != PORTA){
+				enu_return_state = ADC_INVALID_PORT;
+			}else if(ptr_str_arr_channels[u8_slot].enu_channel_pin > PIN7){
+				enu_return_state = ADC_INVALID_PIN;
+			}else{
+				//valid channel
+			}
+		}
+	}
+	
+	if(enu_return_state == ADC_OK){
+		/* a conversion of an earlier scan may still run, its interrupt must not step the new table */
+		CLEAR_BIT(ADCSRA_ADD, ADC_INT_ENABLE);
+		CLEAR_BIT(ADCSRA_ADD, ADC_AUTO_TRIGGER_ENABLE);
+		while(READ_BIT(ADCSRA_ADD, ADC_START_CONVERSION) == U8_ONE_VALUE);
+		for(u8_slot = U8_ZERO_VALUE; u8_slot < copy_u8_count; u8_slot++){
+			gs_u8_arr_scanPins[u8_slot] = ptr_str_arr_channels[u8_slot].enu_channel_pin;
+			gs_u8_arr_scanSequences[u8_slot] = U8_ZERO_VALUE;
+		}
+		gs_u8_scanCount = copy_u8_count;
+		gs_u8_scanSlot = U8_ZERO_VALUE;
+		gs_u8_scanDiscard = ADC_SCAN_SETTLE_DISCARD;
+		gs_u8_scanOversampleBits = ptr_str_adc_config->u8_oversample_bits;
+		gs_u8_scanSumTarget = (uint8_t)(U8_ONE_VALUE << (gs_u8_scanOversampleBits * ADC_SHIFT_BY_2));
+		gs_u16_scanSum = U8_ZERO_VALUE;
+		gs_u8_scanSumCount = U8_ZERO_VALUE;
+		callback_ISR = NULL;
+		adc_end_ISR = NULL;
+		
+		/* right-adjusted codes on the first slot, the interrupt reads ADCL before ADCH */
+		ADMUX_ADD = (ptr_str_adc_config->adc_enu_vref << ADC_VREF_SELECT) | gs_u8_arr_scanPins[U8_ZERO_VALUE];
+		gs_u8_scanRunning = TRUE;
+		/* writing the flag clears a result left by an earlier conversion */
+		ADCSRA_ADD = (1<<ADC_ENABLE) | (1<<ADC_START_CONVERSION) | (1<<ADC_INT_FLAG) | (1<<ADC_INT_ENABLE) | ptr_str_adc_config->adc_enu_prescaler;
+		sei();
+	}else{
+		//the running scan, if any, is left as it is
+	}
+	return enu_return_state;
+}
+
+adc_enu_return_state_t ADC_scan_stop(void){
+	CLEAR_BIT(ADCSRA_ADD, ADC_INT_ENABLE);
+	gs_u8_scanRunning = FALSE;
+	return ADC_OK;
+}
+
+adc_enu_return_state_t ADC_scan_read(uint8_t copy_u8_slot, uint16_t *ptr_u16_code, uint8_t *ptr_u8_sequence){
+	adc_enu_return_state_t enu_return_state = ADC_OK;
+	uint16_t u16_code;
+	uint8_t u8_sequence;
+	
+	if((ptr_u16_code == NULL) || (ptr_u8_sequence == NULL)){
+		enu_return_state = ADC_NULL_PTR;
+	}else if(copy_u8_slot >= gs_u8_scanCount){
+		enu_return_state = ADC_INVALID_SCAN;
+	}else{
+		/* read again if the interrupt stored a new sample of the slot in between */
+		do{
+			u8_sequence = gs_u8_arr_scanSequences[copy_u8_slot];
+			u16_code = gs_u16_arr_scanValues[copy_u8_slot];
+		}while(u8_sequence != gs_u8_arr_scanSequences[copy_u8_slot]);
+		
+		if(u8_sequence == U8_ZERO_VALUE){
+			enu_return_state = ADC_NO_DATA;
+		}else{
+			*ptr_u16_code = u16_code;
+			*ptr_u8_sequence = u8_sequence;
+		}
+	}
+	return enu_return_state;
+}
+
+static void ADC_acquisition_push(void){
+	uint16_t u16_code = ADCL_ADD;
+	uint8_t u8_next_head = (gs_u8_acqHead + U8_ONE_VALUE) & ADC_ACQ_RING_MASK;
+	
+	u16_code |= (uint16_t)ADCH_ADD << ADC_SHIFT_BY_8;
+	/* 4^n codes make one sample, n bits of the sum are dropped and n bits are gained */
+	gs_u16_acqSum += u16_code;
+	gs_u8_acqSumCount++;
+	if(gs_u8_acqSumCount < gs_u8_acqSumTarget){
+		//sample still building
+	}else if(u8_next_head != gs_u8_acqTail){
+		/* the sample is stored before the head publishes it */
+		gs_u16_arr_acqRing[gs_u8_acqHead] = gs_u16_acqSum >> gs_u8_acqOversampleBits;
+		gs_u8_acqHead = u8_next_head;
+		gs_u16_acqSum = U8_ZERO_VALUE;
+		gs_u8_acqSumCount = U8_ZERO_VALUE;
+	}else{
+		if(gs_u16_acqOverruns < 0xFFFF){
+			gs_u16_acqOverruns++;
+		}else{
+			//count saturated
+		}
+		gs_u16_acqSum = U8_ZERO_VALUE;
+		gs_u8_acqSumCount = U8_ZERO_VALUE;
+	}
+}
+
+
+static void ADC_scan_step(void){
+	uint16_t u16_code = ADCL_ADD;
+	uint8_t u8_slot = gs_u8_scanSlot;
+	
+	u16_code |= (uint16_t)ADCH_ADD << ADC_SHIFT_BY_8;
+	if(gs_u8_scanDiscard > U8_ZERO_VALUE){
+		/* converted while the sample-and-hold still followed the last channel */
+		gs_u8_scanDiscard--;
+	}else{
+		gs_u16_scanSum += u16_code;
+		gs_u8_scanSumCount++;
+		if(gs_u8_scanSumCount < gs_u8_scanSumTarget){
+			//sample still building
+		}else{
+			gs_u16_arr_scanValues[u8_slot] = gs_u16_scanSum >> gs_u8_scanOversampleBits;
+			/* the sequence publishes the sample, 0 stays reserved for a slot without one */
+			if(gs_u8_arr_scanSequences[u8_slot] == U8_BIT_REG_MASK){
+				gs_u8_arr_scanSequences[u8_slot] = U8_ONE_VALUE;
+			}else{
+				gs_u8_arr_scanSequences[u8_slot]++;
+			}
+			gs_u16_scanSum = U8_ZERO_VALUE;
+			gs_u8_scanSumCount = U8_ZERO_VALUE;
+			
+			if(gs_u8_scanCount > U8_ONE_VALUE){
+				u8_slot++;
+				if(u8_slot >= gs_u8_scanCount){
+					u8_slot = U8_ZERO_VALUE;
+				}
+				gs_u8_scanSlot = u8_slot;
+				gs_u8_scanDiscard = ADC_SCAN_SETTLE_DISCARD;
+				ADMUX_ADD = (ADC_ADMUX_MASK & ADMUX_ADD) | gs_u8_arr_scanPins[u8_slot];
+			}else{
+				//a single channel never switches
+			}
+		}
+	}
+	/* the multiplexer is only sampled when the conversion starts */
+	SET_BIT(ADCSRA_ADD, ADC_START_CONVERSION);
 }
 
 
 ISR(ADC){
-	double *data;
+	uint16_t *data;
 	adc_str_config_t *adc_config;
-	if(callback_ISR != NULL)
-		(*callback_ISR)(&adc_config, &data);
-	ADC_channel_read_ISR(&adc_config, &data);
-	if(adc_end_ISR != NULL)
-		(*adc_end_ISR)(data);
 	
-	callback_ISR = NULL;
-	adc_end_ISR = NULL;
+	if(gs_u8_acqRunning == TRUE){
+		ADC_acquisition_push();
+	}else if(gs_u8_scanRunning == TRUE){
+		ADC_scan_step();
+	}else{
+		if(callback_ISR != NULL)
+			(*callback_ISR)(&adc_config, &data);
+		ADC_channel_read_ISR(&adc_config, &data);
+		if(adc_end_ISR != NULL)
+			(*adc_end_ISR)(data);
+		
+		callback_ISR = NULL;
+		adc_end_ISR = NULL;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+ * @file DELAY_interface.h
+ * @brief Cycle-counted busy-wait delays derived from F_CPU.
+ *
+ * The delays run a fixed four-cycle loop, so their length depends only on the CPU clock and not on
+ * the optimization level. Loop counts are computed by the preprocessor when the argument is a constant.
+ *
+ * Example usage:
+ * @code{.c}
+ * DELAY_US(40);
+ * DELAY_ms(15);
+ * @endcode
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+
+#ifndef DELAY_INTERFACE_H_
+#define DELAY_INTERFACE_H_
+#include "../../STD_LIB/std_types.h"
+
+#ifndef F_CPU
+/** @brief CPU clock in Hz, used when the build does not define it */
+#define F_CPU								8000000UL
+#endif
+
+/** @brief CPU cycles spent by one pass of the delay loop (sbiw + brne) */
+#define DELAY_LOOP_CYCLES					4UL
+
+/** @brief Microseconds in one millisecond */
+#define DELAY_US_PER_MS						1000UL
+
+#if F_CPU < 1000000UL
+#error F_CPU below 1 MHz, a one microsecond delay would need less than one loop pass
+#endif
+
+/** @brief Microseconds in the 10 ms unit the loop counts are scaled by */
+#define DELAY_US_PER_UNIT					10000UL
+
+/**
+ * @brief CPU cycles in 10 ms, rounded up.
+ *
+ * Exact for crystals such as 14.7456 MHz and 11.0592 MHz that are not whole MHz, and small enough that the cycles of
+ * any delay up to DELAY_US_MAX fit in 32 bits.
+ */
+#define DELAY_CYCLES_PER_UNIT				((F_CPU + 99UL) / 100UL)
+
+/** @brief Longest delay in microseconds that one DELAY_US() call can produce */
+#define DELAY_US_MAX						((65535UL * DELAY_LOOP_CYCLES * DELAY_US_PER_UNIT) / DELAY_CYCLES_PER_UNIT)
+
+/**
+ * @brief Convert microseconds to delay loop passes, rounded up.
+ *
+ * @param US Delay in microseconds, 1 .. DELAY_US_MAX.
+ */
+#define DELAY_US_TO_LOOPS(US)				((uint16_t)(((DELAY_CYCLES_PER_UNIT * (uint32_t)(US)) + (DELAY_LOOP_CYCLES * DELAY_US_PER_UNIT) - 1UL) / (DELAY_LOOP_CYCLES * DELAY_US_PER_UNIT)))
+
+/**
+ * @brief Busy-wait for at least US microseconds.
+ *
+ * @param US Delay in microseconds, 1 .. DELAY_US_MAX. Should be a constant so the loop count is folded at compile time.
+ */
+#define DELAY_US(US)						DELAY_loop(DELAY_US_TO_LOOPS(US))
+
+/**
+ * @brief Run the four-cycle delay loop.
+ *
+ * @param[in] copy_u16_loops Number of loop passes, 1 .. 65535.
+ */
+static inline void DELAY_loop(uint16_t copy_u16_loops)
+{
+	__asm__ __volatile__ (
+		"1: sbiw %0,1" "\n\t"
+		"brne 1b"
+		: "=w" (copy_u16_loops)
+		: "0" (copy_u16_loops)
+	);
+}
+
+/**
+ * @brief Busy-wait for at least the given number of milliseconds.
+ *
+ * @param[in] copy_u16_ms Delay in milliseconds.
+ */
+static inline void DELAY_ms(uint16_t copy_u16_ms)
+{
+	while(copy_u16_ms > 0U)
+	{
+		DELAY_US(DELAY_US_PER_MS);
+		copy_u16_ms--;
+	}
+}
+
+
+#endif /* DELAY_INTERFACE_H_ */
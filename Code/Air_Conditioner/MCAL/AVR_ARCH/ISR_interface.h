@@ -13,6 +13,7 @@
 
 #ifndef ISR_INTERFACE_H_
 #define ISR_INTERFACE_H_
+#include "../../STD_LIB/std_types.h"
 
 
 /** @defgroup InterruptControlMacros Interrupt Control Macros */
@@ -27,6 +28,16 @@
  * @brief Disable global interrupts.
  */
 #define cli() __asm__ __volatile__("cli" ::: "memory")
+
+/**
+ * @brief Status register, holds the global interrupt enable bit.
+ */
+#define ISR_SREG							(*((volatile uint8_t *)0x5F))
+
+/**
+ * @brief Global interrupt enable bit of the status register, clear inside an ISR and after cli().
+ */
+#define ISR_SREG_I_BIT						7
 /** @} */
 
 
@@ -0,0 +1,59 @@
+/**
+ * @file PGM_interface.h
+ * @brief Program memory access.
+ *
+ * This header file defines the attribute that places constant data in flash and the macros that read it back
+ * with the lpm instruction. Data declared PROGMEM is not copied to SRAM at startup, so it must only be read
+ * through these macros.
+ *
+ * Example usage:
+ * @code{.c}
+ * static const uint8_t gs_u8_arr_text[] PROGMEM = "Hello";
+ * uint8_t u8_first = pgm_read_byte(&gs_u8_arr_text[0]);
+ * @endcode
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+
+#ifndef PGM_INTERFACE_H_
+#define PGM_INTERFACE_H_
+#include "../../STD_LIB/std_types.h"
+
+/**
+ * @brief Place a constant object in program memory.
+ */
+#define PROGMEM __attribute__((__progmem__))
+
+/**
+ * @brief Read one byte from program memory.
+ *
+ * @param ADDRESS Flash address of the byte.
+ */
+#define pgm_read_byte(ADDRESS)	(__extension__({				\
+	uint16_t u16_pgm_address = (uint16_t)(ADDRESS);				\
+	uint8_t u8_pgm_result;										\
+	__asm__ __volatile__ ("lpm %0, Z"							\
+		: "=r" (u8_pgm_result)									\
+		: "z" (u16_pgm_address));								\
+	u8_pgm_result;												\
+}))
+
+/**
+ * @brief Read one little-endian word from program memory.
+ *
+ * @param ADDRESS Flash address of the low byte.
+ */
+#define pgm_read_word(ADDRESS)	(__extension__({				\
+	uint16_t u16_pgm_address = (uint16_t)(ADDRESS);				\
+	uint16_t u16_pgm_result;									\
+	__asm__ __volatile__ ("lpm %A0, Z+" "\n\t"					\
+						  "lpm %B0, Z"							\
+		: "=r" (u16_pgm_result), "=z" (u16_pgm_address)			\
+		: "1" (u16_pgm_address));								\
+	u16_pgm_result;												\
+}))
+
+
+#endif /* PGM_INTERFACE_H_ */
@@ -0,0 +1,59 @@
+/**
+ * @file SLEEP_interface.h
+ * @brief Idle sleep of the CPU.
+ *
+ * The idle mode stops the CPU clock only, so the timers, the ADC, the TWI and the external interrupts keep
+ * running and any enabled interrupt wakes the CPU. Execution continues after SLEEP_idle() once the interrupt
+ * has been served.
+ *
+ * The idle check and the sleep must not be split by an interrupt, or work it queues is left waiting until
+ * some later interrupt, which may never come while the keypad waits for a press. Disable interrupts, check,
+ * then call SLEEP_idle(): it enables them again together with the sleep.
+ *
+ * Example usage:
+ * @code{.c}
+ * cli();
+ * KEYPAD_isIdle(&str_keypad_config, &u8_idle);
+ * if(u8_idle == TRUE)
+ * {
+ *     SLEEP_idle();
+ * }
+ * else
+ * {
+ *     sei();
+ * }
+ * @endcode
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+
+#ifndef SLEEP_INTERFACE_H_
+#define SLEEP_INTERFACE_H_
+#include "../../STD_LIB/std_types.h"
+
+/** @brief MCU control register, holds the sleep enable and sleep mode bits */
+#define SLEEP_MCUCR							(*((volatile uint8_t *)0x55))
+
+/** @brief Sleep enable bit of MCUCR */
+#define SLEEP_ENABLE_BIT					7
+
+/** @brief Sleep mode bits of MCUCR, all clear selects idle */
+#define SLEEP_MODE_MASK						((uint8_t)0x70)
+
+/**
+ * @brief Enable interrupts and stop the CPU until the next interrupt.
+ *
+ * Call with interrupts disabled, right after the check that found nothing to do. The instruction after sei
+ * always runs before a pending interrupt is taken, so an interrupt that arrived since the check wakes the CPU
+ * instead of being served before it sleeps. Interrupts are enabled on return.
+ */
+#define SLEEP_idle()	do{ \
+	SLEEP_MCUCR = (uint8_t)((SLEEP_MCUCR & (uint8_t)~SLEEP_MODE_MASK) | (uint8_t)(1 << SLEEP_ENABLE_BIT)); \
+	__asm__ __volatile__("sei" "\n\t" "sleep" ::: "memory"); \
+	SLEEP_MCUCR &= (uint8_t)~(1 << SLEEP_ENABLE_BIT); \
+}while(0)
+
+
+#endif /* SLEEP_INTERFACE_H_ */
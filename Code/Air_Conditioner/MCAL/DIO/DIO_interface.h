@@ -122,6 +122,53 @@ dio_enu_return_state_t DIO_write_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_
  */
 dio_enu_return_state_t DIO_read_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_t copy_enu_pin, dio_enu_level_t	*ptr_enu_state);
 
+/**
+ * @brief Read the levels of all 8 pins of one port.
+ *
+ * This function reads the pin register of the port once, so all pins are sampled at the same instant.
+ *
+ * @param copy_enu_port The port to read.
+ * @param ptr_u8_value Pointer to the variable where the levels will be stored, bit n for pin n.
+ * @return The return state of reading the port.
+ */
+dio_enu_return_state_t DIO_read_port (dio_enu_port_t copy_enu_port, uint8_t *ptr_u8_value);
+
+/**
+ * @brief Set the direction of several pins of one port.
+ *
+ * This function sets the pins selected by the mask to the provided direction and leaves the others unchanged.
+ *
+ * @param copy_enu_port The port to configure.
+ * @param copy_u8_mask Mask of the pins to configure.
+ * @param copy_enu_direction The direction (input or output) to set for the pins.
+ * @return The return state of the port initialization.
+ */
+dio_enu_return_state_t DIO_init_port (dio_enu_port_t copy_enu_port, uint8_t copy_u8_mask, dio_u8_enu_direction_t copy_enu_direction);
+
+/**
+ * @brief Write several pins of one port at once.
+ *
+ * This function writes the bits of the value selected by the mask to the port in a single register update,
+ * leaving the other pins unchanged.
+ *
+ * @param copy_enu_port The port to write.
+ * @param copy_u8_mask Mask of the pins to write.
+ * @param copy_u8_value The levels to write, bit n for pin n.
+ * @return The return state of writing to the port.
+ */
+dio_enu_return_state_t DIO_write_port (dio_enu_port_t copy_enu_port, uint8_t copy_u8_mask, uint8_t copy_u8_value);
+
+/**
+ * @brief Write all 8 pins of one port.
+ *
+ * This function stores the value in the port register with a single write, without reading it back first.
+ *
+ * @param copy_enu_port The port to write.
+ * @param copy_u8_value The levels to write, bit n for pin n.
+ * @return The return state of writing to the port.
+ */
+dio_enu_return_state_t DIO_set_port (dio_enu_port_t copy_enu_port, uint8_t copy_u8_value);
+
 /** @} */
 
 #endif /* DIO_INTERFACE_H_ */
\ No newline at end of file
@@ -19,22 +19,46 @@ dio_enu_return_state_t DIO_init (dio_enu_port_t copy_enu_port, dio_enu_pin_t cop
 	{
 		if (copy_enu_port == PORTA)
 		{
-			DATA_DIRECTION_PORTA |= copy_enu_direction << copy_enu_pin;
+			if (copy_enu_direction == DIO_PIN_OUTPUT)
+			{
+				SET_BIT(DATA_DIRECTION_PORTA, copy_enu_pin);
+			}
+			else{
+				CLEAR_BIT(DATA_DIRECTION_PORTA, copy_enu_pin);
+			}
 			
 		}
 		else if (copy_enu_port == PORTB)
 		{
-			DATA_DIRECTION_PORTB |= copy_enu_direction << copy_enu_pin;
+			if (copy_enu_direction == DIO_PIN_OUTPUT)
+			{
+				SET_BIT(DATA_DIRECTION_PORTB, copy_enu_pin);
+			}
+			else{
+				CLEAR_BIT(DATA_DIRECTION_PORTB, copy_enu_pin);
+			}
 			
 		}
 		else if (copy_enu_port == PORTC)
 		{
-			DATA_DIRECTION_PORTC |= copy_enu_direction << copy_enu_pin;
+			if (copy_enu_direction == DIO_PIN_OUTPUT)
+			{
+				SET_BIT(DATA_DIRECTION_PORTC, copy_enu_pin);
+			}
+			else{
+				CLEAR_BIT(DATA_DIRECTION_PORTC, copy_enu_pin);
+			}
 			
 		}
 		else if (copy_enu_port == PORTD)
 		{
-			DATA_DIRECTION_PORTD |= copy_enu_direction << copy_enu_pin;
+			if (copy_enu_direction == DIO_PIN_OUTPUT)
+			{
+				SET_BIT(DATA_DIRECTION_PORTD, copy_enu_pin);
+			}
+			else{
+				CLEAR_BIT(DATA_DIRECTION_PORTD, copy_enu_pin);
+			}
 			
 		}
 		else
@@ -154,4 +178,144 @@ dio_enu_return_state_t DIO_read_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_t
 	}
 
 	return enu_return_state;
-}
\ No newline at end of file
+}
+
+dio_enu_return_state_t DIO_init_port (dio_enu_port_t copy_enu_port, uint8_t copy_u8_mask, dio_u8_enu_direction_t copy_enu_direction)
+{
+
+	dio_enu_return_state_t enu_return_state = DIO_OK;
+
+	if (copy_enu_port == PORTA)
+	{
+		if (copy_enu_direction == DIO_PIN_OUTPUT)
+		{
+			DATA_DIRECTION_PORTA |= copy_u8_mask;
+		}
+		else{
+			DATA_DIRECTION_PORTA &= ~copy_u8_mask;
+		}
+	}
+	else if (copy_enu_port == PORTB)
+	{
+		if (copy_enu_direction == DIO_PIN_OUTPUT)
+		{
+			DATA_DIRECTION_PORTB |= copy_u8_mask;
+		}
+		else{
+			DATA_DIRECTION_PORTB &= ~copy_u8_mask;
+		}
+	}
+	else if (copy_enu_port == PORTC)
+	{
+		if (copy_enu_direction == DIO_PIN_OUTPUT)
+		{
+			DATA_DIRECTION_PORTC |= copy_u8_mask;
+		}
+		else{
+			DATA_DIRECTION_PORTC &= ~copy_u8_mask;
+		}
+	}
+	else if (copy_enu_port == PORTD)
+	{
+		if (copy_enu_direction == DIO_PIN_OUTPUT)
+		{
+			DATA_DIRECTION_PORTD |= copy_u8_mask;
+		}
+		else{
+			DATA_DIRECTION_PORTD &= ~copy_u8_mask;
+		}
+	}
+	else
+	{
+		enu_return_state = DIO_INVALID_PORT;
+	}
+
+	return enu_return_state;
+}
+
+dio_enu_return_state_t DIO_write_port (dio_enu_port_t copy_enu_port, uint8_t copy_u8_mask, uint8_t copy_u8_value)
+{
+
+	dio_enu_return_state_t enu_return_state = DIO_OK;
+
+	if (copy_enu_port == PORTA)
+	{
+		WR_PORT_A = (WR_PORT_A & ~copy_u8_mask) | (copy_u8_value & copy_u8_mask);
+	}
+	else if (copy_enu_port == PORTB)
+	{
+		WR_PORT_B = (WR_PORT_B & ~copy_u8_mask) | (copy_u8_value & copy_u8_mask);
+	}
+	else if (copy_enu_port == PORTC)
+	{
+		WR_PORT_C = (WR_PORT_C & ~copy_u8_mask) | (copy_u8_value & copy_u8_mask);
+	}
+	else if (copy_enu_port == PORTD)
+	{
+		WR_PORT_D = (WR_PORT_D & ~copy_u8_mask) | (copy_u8_value & copy_u8_mask);
+	}
+	else
+	{
+		enu_return_state = DIO_INVALID_PORT;
+	}
+
+	return enu_return_state;
+}
+
+dio_enu_return_state_t DIO_set_port (dio_enu_port_t copy_enu_port, uint8_t copy_u8_value)
+{
+
+	dio_enu_return_state_t enu_return_state = DIO_OK;
+
+	if (copy_enu_port == PORTA)
+	{
+		WR_PORT_A = copy_u8_value;
+	}
+	else if (copy_enu_port == PORTB)
+	{
+		WR_PORT_B = copy_u8_value;
+	}
+	else if (copy_enu_port == PORTC)
+	{
+		WR_PORT_C = copy_u8_value;
+	}
+	else if (copy_enu_port == PORTD)
+	{
+		WR_PORT_D = copy_u8_value;
+	}
+	else
+	{
+		enu_return_state = DIO_INVALID_PORT;
+	}
+
+	return enu_return_state;
+}
+
+dio_enu_return_state_t DIO_read_port (dio_enu_port_t copy_enu_port, uint8_t *ptr_u8_value)
+{
+
+	dio_enu_return_state_t enu_return_state = DIO_OK;
+
+	if (copy_enu_port == PORTA)
+	{
+		*ptr_u8_value = RE_PORT_A;
+	}
+	else if (copy_enu_port == PORTB)
+	{
+		*ptr_u8_value = RE_PORT_B;
+	}
+	else if (copy_enu_port == PORTC)
+	{
+		*ptr_u8_value = RE_PORT_C;
+	}
+	else if (copy_enu_port == PORTD)
+	{
+		*ptr_u8_value = RE_PORT_D;
+	}
+	else
+	{
+		enu_return_state = DIO_INVALID_PORT;
+	}
+
+	return enu_return_state;
+}
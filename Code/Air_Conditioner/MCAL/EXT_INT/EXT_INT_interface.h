@@ -0,0 +1,103 @@
+/**
+ * @file EXT_INT_interface.h
+ * @brief External interrupt module interface.
+ *
+ * This file contains the interface of the INT0, INT1 and INT2 external interrupts. Each source calls the function
+ * registered for it from its interrupt vector.
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+#ifndef EXT_INT_INTERFACE_H_
+#define EXT_INT_INTERFACE_H_
+
+#include "../../STD_LIB/bit_math.h"
+#include "../../STD_LIB/std_types.h"
+#include "../DIO/DIO_interface.h"
+
+/**
+ * @brief Enumeration for external interrupt module return states.
+ */
+typedef enum{
+	EXT_INT_E_OK,		/**< Operation successful. */
+	EXT_INT_E_NOT_OK,	/**< Invalid source or sense. */
+	EXT_INT_NULL_PTR	/**< Null pointer encountered. */
+} ext_int_enu_return_state_t;
+
+/**
+ * @brief Enumeration for the external interrupt sources.
+ */
+typedef enum{
+	EXT_INT_0 = 0,		/**< INT0 on PD2. */
+	EXT_INT_1,			/**< INT1 on PD3. */
+	EXT_INT_2,			/**< INT2 on PB2, edge sense only. */
+	EXT_INT_INVALID		/**< First invalid source. */
+} ext_int_enu_source_t;
+
+/**
+ * @brief Enumeration for the level or edge that raises the interrupt.
+ */
+typedef enum{
+	EXT_INT_LOW_LEVEL = 0,		/**< Pin low, INT0 and INT1 only. */
+	EXT_INT_ANY_CHANGE,			/**< Any logical change, INT0 and INT1 only. */
+	EXT_INT_FALLING_EDGE,		/**< Falling edge. */
+	EXT_INT_RISING_EDGE,		/**< Rising edge. */
+	EXT_INT_INVALID_SENSE		/**< First invalid sense. */
+} ext_int_enu_sense_t;
+
+
+/**
+ * @brief Initialize an external interrupt source.
+ *
+ * Sets the pin as an input with its pull-up on, selects the sense and registers the callback. The interrupt
+ * stays disabled and its flag is cleared, EXT_INT_enable() arms it.
+ *
+ * A source belongs to the first callback registered on it. Initializing it again with the same callback only
+ * changes the sense, a different callback is refused so that two drivers cannot share one line unnoticed.
+ *
+ * @param[in] copy_enu_source The interrupt source.
+ * @param[in] copy_enu_sense The level or edge that raises the interrupt.
+ * @param[in] ptr_v_fun_in_v Function called from the interrupt vector.
+ * @return Status of the initialization operation, EXT_INT_E_NOT_OK if the source is claimed by another callback.
+ */
+ext_int_enu_return_state_t EXT_INT_init(ext_int_enu_source_t copy_enu_source, ext_int_enu_sense_t copy_enu_sense, ptr_to_v_fun_in_void_t ptr_v_fun_in_v);
+
+/**
+ * @brief Enable an external interrupt source.
+ *
+ * An edge latched while the source was disabled raises the interrupt as soon as it is enabled. Global
+ * interrupts are left as they are, so this is safe to call from another interrupt.
+ *
+ * @param[in] copy_enu_source The interrupt source.
+ * @return Status of the operation.
+ */
+ext_int_enu_return_state_t EXT_INT_enable(ext_int_enu_source_t copy_enu_source);
+
+/**
+ * @brief Disable an external interrupt source.
+ *
+ * @param[in] copy_enu_source The interrupt source.
+ * @return Status of the operation.
+ */
+ext_int_enu_return_state_t EXT_INT_disable(ext_int_enu_source_t copy_enu_source);
+
+/**
+ * @brief Clear the latched flag of an external interrupt source.
+ *
+ * @param[in] copy_enu_source The interrupt source.
+ * @return Status of the operation.
+ */
+ext_int_enu_return_state_t EXT_INT_clearFlag(ext_int_enu_source_t copy_enu_source);
+
+/**
+ * @brief Read the level of the pin of an external interrupt source.
+ *
+ * @param[in] copy_enu_source The interrupt source.
+ * @param[out] ptr_enu_level Pointer to store the level of the pin.
+ * @return Status of the operation.
+ */
+ext_int_enu_return_state_t EXT_INT_readPin(ext_int_enu_source_t copy_enu_source, dio_enu_level_t *ptr_enu_level);
+
+
+#endif /* EXT_INT_INTERFACE_H_ */
@@ -0,0 +1,39 @@
+/**
+ * @file EXT_INT_private.h
+ * @brief External interrupt module private register definitions.
+ *
+ * This file contains the definitions of private registers and bit fields used by the external interrupt module.
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+#ifndef EXT_INT_PRIVATE_H_
+#define EXT_INT_PRIVATE_H_
+
+#define MCUCR_ADD	(*((volatile uint8_t *)0x55))
+#define EXT_INT_ISC00		0
+#define EXT_INT_ISC10		2
+#define EXT_INT_SENSE_MASK	((uint8_t)0x03)
+
+#define MCUCSR_ADD	(*((volatile uint8_t *)0x54))
+#define EXT_INT_ISC2		6
+
+#define GICR_ADD	(*((volatile uint8_t *)0x5B))
+#define EXT_INT_INT1		7
+#define EXT_INT_INT0		6
+#define EXT_INT_INT2		5
+
+/* GIFR flags sit on the same bits as the GICR enables, a flag is cleared by writing one to it */
+#define GIFR_ADD	(*((volatile uint8_t *)0x5A))
+
+/* Pins of the interrupt inputs */
+#define EXT_INT_0_PORT		PORTD
+#define EXT_INT_0_PIN		PIN2
+#define EXT_INT_1_PORT		PORTD
+#define EXT_INT_1_PIN		PIN3
+#define EXT_INT_2_PORT		PORTB
+#define EXT_INT_2_PIN		PIN2
+
+
+#endif
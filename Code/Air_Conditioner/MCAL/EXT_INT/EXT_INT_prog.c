@@ -0,0 +1,142 @@
+/**
+ * @file EXT_INT_prog.c
+ * @brief External interrupt module implementation.
+ *
+ * This file contains the implementation of the INT0, INT1 and INT2 external interrupts.
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+
+#include "EXT_INT_private.h"
+#include "EXT_INT_interface.h"
+#include "../AVR_ARCH/ISR_interface.h"
+
+/**< Functions called from the interrupt vectors, indexed by source. */
+static ptr_to_v_fun_in_void_t volatile gs_ptr_arr_callBack[EXT_INT_INVALID] = {NULL, NULL, NULL};
+
+/**< GICR enable bit of each source, the matching GIFR flag sits on the same bit. */
+static const uint8_t gs_u8_arr_enableBit[EXT_INT_INVALID] = {EXT_INT_INT0, EXT_INT_INT1, EXT_INT_INT2};
+
+ext_int_enu_return_state_t EXT_INT_init(ext_int_enu_source_t copy_enu_source, ext_int_enu_sense_t copy_enu_sense, ptr_to_v_fun_in_void_t ptr_v_fun_in_v){
+	ext_int_enu_return_state_t enu_return_state = EXT_INT_E_OK;
+	if(ptr_v_fun_in_v == NULL){
+		enu_return_state = EXT_INT_NULL_PTR;
+	}
+	else if((copy_enu_source >= EXT_INT_INVALID) || (copy_enu_sense >= EXT_INT_INVALID_SENSE)){
+		enu_return_state = EXT_INT_E_NOT_OK;
+	}
+	else if((copy_enu_source == EXT_INT_2) && (copy_enu_sense < EXT_INT_FALLING_EDGE)){
+		enu_return_state = EXT_INT_E_NOT_OK;
+	}
+	else if((gs_ptr_arr_callBack[copy_enu_source] != NULL) && (gs_ptr_arr_callBack[copy_enu_source] != ptr_v_fun_in_v)){
+		/* the line is claimed by another driver, overwriting its callback would silence it */
+		enu_return_state = EXT_INT_E_NOT_OK;
+	}
+	else{
+		CLEAR_BIT(GICR_ADD, gs_u8_arr_enableBit[copy_enu_source]);
+		gs_ptr_arr_callBack[copy_enu_source] = ptr_v_fun_in_v;
+		switch(copy_enu_source){
+			case EXT_INT_0:
+				DIO_init(EXT_INT_0_PORT, EXT_INT_0_PIN, DIO_PIN_INPUT);
+				DIO_write_pin(EXT_INT_0_PORT, EXT_INT_0_PIN, DIO_PIN_HIGH_LEVEL);
+				MCUCR_ADD = (MCUCR_ADD & (uint8_t)~(EXT_INT_SENSE_MASK << EXT_INT_ISC00)) | (uint8_t)(copy_enu_sense << EXT_INT_ISC00);
+				break;
+			case EXT_INT_1:
+				DIO_init(EXT_INT_1_PORT, EXT_INT_1_PIN, DIO_PIN_INPUT);
+				DIO_write_pin(EXT_INT_1_PORT, EXT_INT_1_PIN, DIO_PIN_HIGH_LEVEL);
+				MCUCR_ADD = (MCUCR_ADD & (uint8_t)~(EXT_INT_SENSE_MASK << EXT_INT_ISC10)) | (uint8_t)(copy_enu_sense << EXT_INT_ISC10);
+				break;
+			default:
+				DIO_init(EXT_INT_2_PORT, EXT_INT_2_PIN, DIO_PIN_INPUT);
+				DIO_write_pin(EXT_INT_2_PORT, EXT_INT_2_PIN, DIO_PIN_HIGH_LEVEL);
+				if(copy_enu_sense == EXT_INT_RISING_EDGE){
+					SET_BIT(MCUCSR_ADD, EXT_INT_ISC2);
+				}
+				else{
+					CLEAR_BIT(MCUCSR_ADD, EXT_INT_ISC2);
+				}
+				break;
+		}
+		/* changing the sense can latch a false edge */
+		GIFR_ADD = (uint8_t)(1 << gs_u8_arr_enableBit[copy_enu_source]);
+	}
+	return enu_return_state;
+}
+
+ext_int_enu_return_state_t EXT_INT_enable(ext_int_enu_source_t copy_enu_source){
+	ext_int_enu_return_state_t enu_return_state = EXT_INT_E_OK;
+	if(copy_enu_source >= EXT_INT_INVALID){
+		enu_return_state = EXT_INT_E_NOT_OK;
+	}
+	else{
+		SET_BIT(GICR_ADD, gs_u8_arr_enableBit[copy_enu_source]);
+	}
+	return enu_return_state;
+}
+
+ext_int_enu_return_state_t EXT_INT_disable(ext_int_enu_source_t copy_enu_source){
+	ext_int_enu_return_state_t enu_return_state = EXT_INT_E_OK;
+	if(copy_enu_source >= EXT_INT_INVALID){
+		enu_return_state = EXT_INT_E_NOT_OK;
+	}
+	else{
+		CLEAR_BIT(GICR_ADD, gs_u8_arr_enableBit[copy_enu_source]);
+	}
+	return enu_return_state;
+}
+
+ext_int_enu_return_state_t EXT_INT_clearFlag(ext_int_enu_source_t copy_enu_source){
+	ext_int_enu_return_state_t enu_return_state = EXT_INT_E_OK;
+	if(copy_enu_source >= EXT_INT_INVALID){
+		enu_return_state = EXT_INT_E_NOT_OK;
+	}
+	else{
+		/* writing zeros leaves the other flags set */
+		GIFR_ADD = (uint8_t)(1 << gs_u8_arr_enableBit[copy_enu_source]);
+	}
+	return enu_return_state;
+}
+
+ext_int_enu_return_state_t EXT_INT_readPin(ext_int_enu_source_t copy_enu_source, dio_enu_level_t *ptr_enu_level){
+	ext_int_enu_return_state_t enu_return_state = EXT_INT_E_OK;
+	if(ptr_enu_level == NULL){
+		enu_return_state = EXT_INT_NULL_PTR;
+	}
+	else{
+		switch(copy_enu_source){
+			case EXT_INT_0:
+				DIO_read_pin(EXT_INT_0_PORT, EXT_INT_0_PIN, ptr_enu_level);
+				break;
+			case EXT_INT_1:
+				DIO_read_pin(EXT_INT_1_PORT, EXT_INT_1_PIN, ptr_enu_level);
+				break;
+			case EXT_INT_2:
+				DIO_read_pin(EXT_INT_2_PORT, EXT_INT_2_PIN, ptr_enu_level);
+				break;
+			default:
+				enu_return_state = EXT_INT_E_NOT_OK;
+				break;
+		}
+	}
+	return enu_return_state;
+}
+
+ISR(EXT_INT0){
+	if(gs_ptr_arr_callBack[EXT_INT_0] != NULL){
+		gs_ptr_arr_callBack[EXT_INT_0]();
+	}
+}
+
+ISR(EXT_INT1){
+	if(gs_ptr_arr_callBack[EXT_INT_1] != NULL){
+		gs_ptr_arr_callBack[EXT_INT_1]();
+	}
+}
+
+ISR(EXT_INT2){
+	if(gs_ptr_arr_callBack[EXT_INT_2] != NULL){
+		gs_ptr_arr_callBack[EXT_INT_2]();
+	}
+}
@@ -143,6 +143,15 @@ timer_enu_return_state_t TIMERx_setCallBack( ptr_to_v_fun_in_void_t ptr_v_fun_in
 */
 timer_enu_return_state_t TIMERx_setValue(const timer_enu_timer_number_t copy_enu_timer_number ,const uint16_t copy_u16_timer_init_value);
 
+/*
+* Description :read the value of the timer counting register 
+* @param the  timer type and a pointer to store the value
+* @return status of the function
+*  TIMER_OK :the function done successfully
+*  TIMER_NOT_OK :the function has issues performing the function
+*/
+timer_enu_return_state_t TIMERx_getValue(const timer_enu_timer_number_t copy_enu_timer_number ,uint16_t *ptr_u16_timer_value);
+
 /*
 * Description :this function sets the offset of the compare unit 
 * @param timer type and the top value to be compared with the TCNCx
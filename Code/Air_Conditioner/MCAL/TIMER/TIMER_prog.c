@@ -23,9 +23,7 @@ ISR(TIMER1_OVF)
 {
 	if(g_Timer1_callBackPtr != NULL)
 	{
-		// The TIMER_0 overflow  occurred (must be cleared in software) 
-		CLEAR_BIT(TIFR,TOV1);
-		// Call the Call Back function in the upper layer after the timer overflow
+		// Call the Call Back function in the upper layer after the timer overflow (the flag is cleared by hardware)
 		(*g_Timer1_callBackPtr)();
 	}
 }
@@ -33,13 +31,44 @@ ISR(TIMER0_OVF)
 {
 	if(g_Timer0_callBackPtr != NULL)
 	{
-		// The TIMER_0 overflow  occurred (must be cleared in software) 
-		 CLEAR_BIT(TIFR,TOV0);
-		//Call the Call Back function in the upper layer after the timer overflow
+		// Call the Call Back function in the upper layer after the timer overflow (the flag is cleared by hardware)
 		(*g_Timer0_callBackPtr)();
 	}
 }
 
+ISR(TIMER0_COMP)
+{
+	if(g_Timer0_callBackPtr != NULL)
+	{
+		// Call the Call Back function in the upper layer after the compare match (the flag is cleared by hardware)
+		(*g_Timer0_callBackPtr)();
+	}
+}
+ISR(TIMER1_COMPA)
+{
+	if(g_Timer1_callBackPtr != NULL)
+	{
+		// Call the Call Back function in the upper layer after the compare match (the flag is cleared by hardware)
+		(*g_Timer1_callBackPtr)();
+	}
+}
+ISR(TIMER2_OVF)
+{
+	if(g_Timer2_callBackPtr != NULL)
+	{
+		// Call the Call Back function in the upper layer after the timer overflow (the flag is cleared by hardware)
+		(*g_Timer2_callBackPtr)();
+	}
+}
+ISR(TIMER2_COMP)
+{
+	if(g_Timer2_callBackPtr != NULL)
+	{
+		// Call the Call Back function in the upper layer after the compare match (the flag is cleared by hardware)
+		(*g_Timer2_callBackPtr)();
+	}
+}
+
 timer_enu_return_state_t TIMERx_setCallBack(  ptr_to_v_fun_in_void_t ptr_v_fun_in_v, const  timer_enu_timer_number_t copy_enu_timer_number )
 {
 	 timer_enu_return_state_t  enu_return_state =  TIMER_OK;
@@ -178,6 +207,43 @@ timer_enu_return_state_t TIMERx_setValue(const  timer_enu_timer_number_t copy_en
 	return  enu_return_state;
 }
 
+timer_enu_return_state_t TIMERx_getValue(const  timer_enu_timer_number_t copy_enu_timer_number ,uint16_t *ptr_u16_timer_value)
+{
+	 timer_enu_return_state_t  enu_return_state =  TIMER_OK;
+	uint8_t u8_sreg;
+	if( (copy_enu_timer_number >= INVALID_TIMER_TYPE) || (ptr_u16_timer_value == NULL) )
+	{
+		 enu_return_state =  TIMER_NOT_OK;
+	}
+	else
+	{
+		switch(copy_enu_timer_number)
+		{
+			case TIMER_0:
+				*ptr_u16_timer_value = TCNT0;
+				break;
+				
+			case TIMER_1:
+				/* the low byte is read first, it latches the high byte in the TEMP register that every 16-bit
+				 * access of timer 1 shares, so an interrupt touching timer 1 in between must be kept out */
+				u8_sreg = ISR_SREG;
+				cli();
+				*ptr_u16_timer_value = TCNT1;
+				ISR_SREG = u8_sreg;
+				break;
+				
+			case TIMER_2:
+				*ptr_u16_timer_value = TCNT2;
+				break;
+				
+			default:
+				 enu_return_state |=  TIMER_NOT_OK;
+				break;
+		}
+	}
+	return  enu_return_state;
+}
+
 timer_enu_return_state_t TIMERx_CTC_SetCompare(const  timer_enu_timer_number_t copy_enu_timer_number ,const uint16_t copy_u16_compare_value)
 {
 	 timer_enu_return_state_t  enu_return_state =  TIMER_OK;
@@ -0,0 +1,20 @@
+/**
+ * @file TWI_config.h
+ * @brief TWI module configuration.
+ *
+ * This file contains the configuration parameters for the TWI master.
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+
+#ifndef TWI_CONFIG_H_
+#define TWI_CONFIG_H_
+
+/**< Requested SCL frequency in Hz (fast mode). */
+#define TWI_SCL_FREQ_HZ			400000UL
+
+
+
+#endif /* TWI_CONFIG_H_ */
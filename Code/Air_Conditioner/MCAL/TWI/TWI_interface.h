@@ -0,0 +1,90 @@
+/**
+ * @file TWI_interface.h
+ * @brief TWI module interface.
+ *
+ * This file contains the interface of the interrupt-driven TWI (I2C) master. A write transaction is started
+ * with one call and then streamed byte by byte from the TWI interrupt, so the caller never waits on the bus.
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+#ifndef TWI_INTERFACE_H_
+#define TWI_INTERFACE_H_
+
+#include "TWI_config.h"
+#include "../../STD_LIB/bit_math.h"
+#include "../AVR_ARCH/DELAY_interface.h"
+
+#ifndef TWI_SCL_FREQ_HZ
+#error TWI SCL frequency
+#endif
+
+/**< Highest 7-bit slave address. */
+#define TWI_ADDRESS_MAX			0x7F
+
+/**
+ * @brief Enumeration for TWI module return states.
+ */
+typedef enum{
+	TWI_E_OK,			/**< Operation successful. */
+	TWI_E_NOT_OK,		/**< Invalid address or length. */
+	TWI_E_BUSY,			/**< A transaction is still in progress. */
+	TWI_NULL_PTR		/**< Null pointer encountered. */
+} twi_enu_return_state_t;
+
+/**
+ * @brief Enumeration for the outcome of the last transaction.
+ */
+typedef enum{
+	TWI_RESULT_OK,			/**< Every byte was acknowledged. */
+	TWI_RESULT_NACK,		/**< The slave did not acknowledge its address or a data byte. */
+	TWI_RESULT_BUS_ERROR	/**< Arbitration lost or unexpected bus state. */
+} twi_enu_result_t;
+
+
+/**
+ * @brief Initialize the TWI as a master.
+ *
+ * Sets the bit rate for TWI_SCL_FREQ_HZ. TWBR is kept at or above the datasheet's master-mode minimum of 10,
+ * so the bus runs at the nearest frequency the CPU clock allows (222 kHz at 8 MHz).
+ *
+ * @return Status of the initialization operation.
+ */
+twi_enu_return_state_t TWI_init(void);
+
+/**
+ * @brief Start a write transaction.
+ *
+ * Sends a start condition, the slave address and copy_u8_length bytes, then a stop condition. Everything after
+ * the start runs in the TWI interrupt; the buffer must stay unchanged until TWI_isIdle() reports TRUE.
+ * The global interrupt enable is left as the caller has it, so this can be called from another interrupt.
+ *
+ * @param[in] copy_u8_address 7-bit slave address.
+ * @param[in] ptr_u8_data Pointer to the bytes to send.
+ * @param[in] copy_u8_length Number of bytes to send, at least 1.
+ * @return Status of the operation, TWI_E_BUSY if the previous transaction has not finished.
+ */
+twi_enu_return_state_t TWI_masterWrite(uint8_t copy_u8_address, const uint8_t *ptr_u8_data, uint8_t copy_u8_length);
+
+/**
+ * @brief Check whether the bus is free for a new transaction.
+ *
+ * With interrupts disabled the TWI interrupt cannot run, so each call serves a pending TWI flag itself and a
+ * loop that waits on this function still sees the transaction finish.
+ *
+ * @param[out] ptr_u8_idle TRUE once the last transaction has sent its stop condition, FALSE otherwise.
+ * @return Status of the operation.
+ */
+twi_enu_return_state_t TWI_isIdle(uint8_t *ptr_u8_idle);
+
+/**
+ * @brief Get the outcome of the last finished transaction.
+ *
+ * @param[out] ptr_enu_result Outcome of the transaction.
+ * @return Status of the operation.
+ */
+twi_enu_return_state_t TWI_lastResult(twi_enu_result_t *ptr_enu_result);
+
+
+#endif /* TWI_INTERFACE_H_ */
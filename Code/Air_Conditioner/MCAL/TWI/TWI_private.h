@@ -0,0 +1,59 @@
+/**
+ * @file TWI_private.h
+ * @brief TWI module private register definitions.
+ *
+ * This file contains the definitions of private registers, bit fields and master transmitter status codes
+ * used by the TWI module.
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+#ifndef TWI_PRIVATE_H_
+#define TWI_PRIVATE_H_
+
+#define TWBR_ADD	(*((volatile uint8_t *)0x20))
+
+#define TWSR_ADD	(*((volatile uint8_t *)0x21))
+#define TWI_PRESCALER_MASK	((uint8_t)0x03)
+#define TWI_STATUS_MASK		((uint8_t)0xF8)
+
+#define TWDR_ADD	(*((volatile uint8_t *)0x23))
+
+#define TWCR_ADD	(*((volatile uint8_t *)0x56))
+#define TWI_INT_FLAG		7
+#define TWI_ENABLE_ACK		6
+#define TWI_START			5
+#define TWI_STOP			4
+#define TWI_WRITE_COLLISION	3
+#define TWI_ENABLE			2
+#define TWI_INT_ENABLE		0
+
+/* Master transmitter status codes (TWSR with the prescaler bits masked) */
+#define TWI_STATUS_START			((uint8_t)0x08)
+#define TWI_STATUS_REP_START		((uint8_t)0x10)
+#define TWI_STATUS_SLA_W_ACK		((uint8_t)0x18)
+#define TWI_STATUS_SLA_W_NACK		((uint8_t)0x20)
+#define TWI_STATUS_DATA_ACK			((uint8_t)0x28)
+#define TWI_STATUS_DATA_NACK		((uint8_t)0x30)
+#define TWI_STATUS_ARB_LOST			((uint8_t)0x38)
+#define TWI_STATUS_BUS_ERROR		((uint8_t)0x00)
+
+/* TWCR values of the master steps, the interrupt stays enabled until the stop */
+#define TWI_CR_START		((uint8_t)((1 << TWI_INT_FLAG) | (1 << TWI_START) | (1 << TWI_ENABLE) | (1 << TWI_INT_ENABLE)))
+#define TWI_CR_SEND			((uint8_t)((1 << TWI_INT_FLAG) | (1 << TWI_ENABLE) | (1 << TWI_INT_ENABLE)))
+#define TWI_CR_STOP			((uint8_t)((1 << TWI_INT_FLAG) | (1 << TWI_STOP) | (1 << TWI_ENABLE)))
+#define TWI_CR_RELEASE		((uint8_t)((1 << TWI_INT_FLAG) | (1 << TWI_ENABLE)))
+
+/* Address byte of a write to a 7-bit slave address */
+#define TWI_SLA_W(ADDRESS)	((uint8_t)((ADDRESS) << 1))
+
+/* SCL = F_CPU / (16 + 2 * TWBR) with the prescaler at 1 */
+#define TWI_SCL_BASE_CYCLES		16UL
+#define TWI_BIT_RATE_VALUE		((F_CPU / TWI_SCL_FREQ_HZ - TWI_SCL_BASE_CYCLES) / 2UL)
+
+/* Smallest TWBR the datasheet allows in master mode */
+#define TWI_BIT_RATE_MIN		10UL
+
+
+#endif
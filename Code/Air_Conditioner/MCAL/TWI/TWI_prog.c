@@ -0,0 +1,152 @@
+/**
+ * @file TWI_prog.c
+ * @brief TWI module implementation.
+ *
+ * This file contains the implementation of the interrupt-driven TWI master transmitter.
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+
+#include "TWI_private.h"
+#include "TWI_interface.h"
+#include "../AVR_ARCH/ISR_interface.h"
+
+#if ((F_CPU / TWI_SCL_FREQ_HZ) < (TWI_SCL_BASE_CYCLES + (2UL * TWI_BIT_RATE_MIN)))
+#define TWI_BIT_RATE	TWI_BIT_RATE_MIN
+#else
+#define TWI_BIT_RATE	TWI_BIT_RATE_VALUE
+#endif
+
+/**< Bytes of the transaction in progress. */
+static const uint8_t * volatile gs_ptr_u8_txData;
+
+/**< Number of bytes of the transaction in progress. */
+static volatile uint8_t gs_u8_txLength;
+
+/**< Index of the next byte to send. */
+static volatile uint8_t gs_u8_txIndex;
+
+/**< Address byte of the transaction in progress. */
+static volatile uint8_t gs_u8_slaW;
+
+/**< TRUE from the start condition until the stop condition. */
+static volatile uint8_t gs_u8_busy = FALSE;
+
+/**< Outcome of the last finished transaction. */
+static volatile twi_enu_result_t gs_enu_lastResult = TWI_RESULT_OK;
+
+/**
+ * @brief Serve one TWINT event of the master transmitter.
+ *
+ * Called from the TWI vector, or from TWI_isIdle() while interrupts are disabled and the vector cannot run.
+ */
+static void TWI_step(void);
+
+twi_enu_return_state_t TWI_init(void){
+	TWSR_ADD &= (uint8_t)~TWI_PRESCALER_MASK;
+	TWBR_ADD = (uint8_t)TWI_BIT_RATE;
+	TWCR_ADD = (1 << TWI_ENABLE);
+	gs_u8_busy = FALSE;
+	gs_enu_lastResult = TWI_RESULT_OK;
+	return TWI_E_OK;
+}
+
+twi_enu_return_state_t TWI_masterWrite(uint8_t copy_u8_address, const uint8_t *ptr_u8_data, uint8_t copy_u8_length){
+	twi_enu_return_state_t enu_return_state = TWI_E_OK;
+	if(ptr_u8_data == NULL){
+		enu_return_state = TWI_NULL_PTR;
+	}
+	else if((copy_u8_address > TWI_ADDRESS_MAX) || (copy_u8_length == U8_ZERO_VALUE)){
+		enu_return_state = TWI_E_NOT_OK;
+	}
+	else if(gs_u8_busy == TRUE){
+		enu_return_state = TWI_E_BUSY;
+	}
+	else{
+		/* the stop of the previous transaction is still being sent for a few SCL periods */
+		while(READ_BIT(TWCR_ADD, TWI_STOP) == U8_ONE_VALUE);
+		gs_ptr_u8_txData = ptr_u8_data;
+		gs_u8_txLength = copy_u8_length;
+		gs_u8_txIndex = U8_ZERO_VALUE;
+		gs_u8_slaW = TWI_SLA_W(copy_u8_address);
+		gs_u8_busy = TRUE;
+		TWCR_ADD = TWI_CR_START;
+	}
+	return enu_return_state;
+}
+
+twi_enu_return_state_t TWI_isIdle(uint8_t *ptr_u8_idle){
+	twi_enu_return_state_t enu_return_state = TWI_E_OK;
+	if(ptr_u8_idle == NULL){
+		enu_return_state = TWI_NULL_PTR;
+	}
+	else{
+		if((gs_u8_busy == TRUE) && (READ_BIT(ISR_SREG, ISR_SREG_I_BIT) == U8_ZERO_VALUE) && (READ_BIT(TWCR_ADD, TWI_INT_FLAG) == U8_ONE_VALUE)){
+			/* the vector cannot run with interrupts disabled, a wait loop on this function drives the transaction */
+			TWI_step();
+		}
+		else{
+			//the vector serves the flag
+		}
+		*ptr_u8_idle = (gs_u8_busy == TRUE) ? FALSE : TRUE;
+	}
+	return enu_return_state;
+}
+
+twi_enu_return_state_t TWI_lastResult(twi_enu_result_t *ptr_enu_result){
+	twi_enu_return_state_t enu_return_state = TWI_E_OK;
+	if(ptr_enu_result == NULL){
+		enu_return_state = TWI_NULL_PTR;
+	}
+	else{
+		*ptr_enu_result = gs_enu_lastResult;
+	}
+	return enu_return_state;
+}
+
+static void TWI_step(void){
+	switch(TWSR_ADD & TWI_STATUS_MASK){
+		case TWI_STATUS_START:
+		case TWI_STATUS_REP_START:
+			TWDR_ADD = gs_u8_slaW;
+			TWCR_ADD = TWI_CR_SEND;
+			break;
+		case TWI_STATUS_SLA_W_ACK:
+		case TWI_STATUS_DATA_ACK:
+			if(gs_u8_txIndex < gs_u8_txLength){
+				TWDR_ADD = gs_ptr_u8_txData[gs_u8_txIndex];
+				gs_u8_txIndex++;
+				TWCR_ADD = TWI_CR_SEND;
+			}
+			else{
+				TWCR_ADD = TWI_CR_STOP;
+				gs_enu_lastResult = TWI_RESULT_OK;
+				gs_u8_busy = FALSE;
+			}
+			break;
+		case TWI_STATUS_SLA_W_NACK:
+		case TWI_STATUS_DATA_NACK:
+			TWCR_ADD = TWI_CR_STOP;
+			gs_enu_lastResult = TWI_RESULT_NACK;
+			gs_u8_busy = FALSE;
+			break;
+		case TWI_STATUS_BUS_ERROR:
+			/* illegal start or stop: the stop request only resets the hardware, nothing is sent on the bus */
+			TWCR_ADD = TWI_CR_STOP;
+			gs_enu_lastResult = TWI_RESULT_BUS_ERROR;
+			gs_u8_busy = FALSE;
+			break;
+		default:
+			/* arbitration lost: let go of the bus without a stop */
+			TWCR_ADD = TWI_CR_RELEASE;
+			gs_enu_lastResult = TWI_RESULT_BUS_ERROR;
+			gs_u8_busy = FALSE;
+			break;
+	}
+}
+
+ISR(TWI){
+	TWI_step();
+}
@@ -0,0 +1,114 @@
+/**
+ * @file FILTER_interface.h
+ * @brief Integer filters for fixed-point sample streams.
+ *
+ * This file declares filter stages for signed 16-bit samples in any Q-format: a running-sum moving average, a
+ * first-order IIR with a shift for its coefficient and a median of 3 or 5 by a sorting network. Stages are kept
+ * in caller arrays and chained in order, one chain per channel. Past the first sample no stage loops over its
+ * history, divides or multiplies, so the cost of a sample is fixed.
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+#ifndef FILTER_INTERFACE_H_
+#define FILTER_INTERFACE_H_
+
+#include "../bit_math.h"
+
+/** @brief Most bits of a moving-average length, the window holds up to 2^FILTER_AVG_MAX_BITS samples */
+#define FILTER_AVG_MAX_BITS				4
+
+/** @brief Longest moving-average window, in samples */
+#define FILTER_AVG_MAX_LENGTH			(1 << FILTER_AVG_MAX_BITS)
+
+/** @brief Largest IIR shift, the coefficient is 1/2^shift; the scaled state still fits 32 bits */
+#define FILTER_IIR_MAX_SHIFT			8
+
+/** @brief Lengths of the median stage */
+#define FILTER_MEDIAN_3					3
+#define FILTER_MEDIAN_5					5
+
+/**
+ * @brief Enumeration for filter module return states.
+ *
+ * FILTER_E_OK (operation successful), FILTER_E_NOT_OK (invalid type or order) and FILTER_NULL_PTR (NULL pointer
+ * provided).
+ */
+typedef enum {
+	FILTER_E_OK,		/**< Operation successful. */
+	FILTER_E_NOT_OK,	/**< Invalid type or order. */
+	FILTER_NULL_PTR		/**< NULL pointer provided. */
+} filter_enu_return_state_t;
+
+/**
+ * @brief Enumeration for the kind of a filter stage.
+ */
+typedef enum {
+	FILTER_AVERAGE,		/**< Moving average of 2^order samples. */
+	FILTER_IIR,			/**< y += (x - y) / 2^order. */
+	FILTER_MEDIAN,		/**< Median of the last order samples, FILTER_MEDIAN_3 or FILTER_MEDIAN_5. */
+	FILTER_TYPE_INVALID	/**< Invalid stage kind. */
+} filter_enu_type_t;
+
+/**
+ * @brief Structure for one filter stage.
+ *
+ * Set up with FILTER_init, the fields are private to the module. The first sample after FILTER_init or
+ * FILTER_reset fills the whole history, so a stage starts at the input level instead of ramping up from zero.
+ */
+typedef struct {
+	filter_enu_type_t enu_type;								/**< Kind of the stage. */
+	uint8_t u8_order;										/**< Length bits, shift or median length. */
+	uint8_t u8_primed;										/**< FALSE until the first sample. */
+	uint8_t u8_index;										/**< Oldest history slot. */
+	sint32_t s32_acc;										/**< Window sum of the average, state scaled by 2^order of the IIR. */
+	sint16_t arr_s16_history[FILTER_AVG_MAX_LENGTH];		/**< Window of the average, last samples of the median. */
+} filter_str_stage_t;
+
+/**
+ * @brief Set up a filter stage.
+ *
+ * @param[out] ptr_str_stage Stage to set up.
+ * @param[in] copy_enu_type Kind of the stage.
+ * @param[in] copy_u8_order Length bits of a FILTER_AVERAGE (0 .. FILTER_AVG_MAX_BITS), shift of a FILTER_IIR
+ *            (0 .. FILTER_IIR_MAX_SHIFT), or FILTER_MEDIAN_3 or FILTER_MEDIAN_5 for a FILTER_MEDIAN.
+ * @return Operation status: FILTER_E_OK if successful, FILTER_E_NOT_OK if the type or order is invalid, FILTER_NULL_PTR if NULL pointer provided.
+ */
+filter_enu_return_state_t FILTER_init (filter_str_stage_t *ptr_str_stage, filter_enu_type_t copy_enu_type, uint8_t copy_u8_order);
+
+/**
+ * @brief Forget the history of a stage, the next sample primes it again.
+ *
+ * @param[in,out] ptr_str_stage Stage set up by FILTER_init.
+ * @return Operation status: FILTER_E_OK if successful, FILTER_NULL_PTR if NULL pointer provided.
+ */
+filter_enu_return_state_t FILTER_reset (filter_str_stage_t *ptr_str_stage);
+
+/**
+ * @brief Pass one sample through one stage.
+ *
+ * The output keeps the Q-format of the input; averages are rounded to the nearest value.
+ *
+ * @param[in,out] ptr_str_stage Stage set up by FILTER_init.
+ * @param[in] copy_s16_sample Input sample.
+ * @param[out] ptr_s16_output Filtered sample.
+ * @return Operation status: FILTER_E_OK if successful, FILTER_E_NOT_OK if the stage is not set up, FILTER_NULL_PTR if NULL pointer provided.
+ */
+filter_enu_return_state_t FILTER_run (filter_str_stage_t *ptr_str_stage, sint16_t copy_s16_sample, sint16_t *ptr_s16_output);
+
+/**
+ * @brief Pass one sample through a chain of stages, each output feeding the next stage.
+ *
+ * A median first and an average or IIR after it drops single spikes before they are smeared into the mean.
+ *
+ * @param[in,out] ptr_str_arr_stages Stages in chain order.
+ * @param[in] copy_u8_count Number of stages.
+ * @param[in] copy_s16_sample Input sample.
+ * @param[out] ptr_s16_output Output of the last stage, the input itself for an empty chain.
+ * @return Operation status: FILTER_E_OK if successful, FILTER_E_NOT_OK if a stage is not set up, FILTER_NULL_PTR if NULL pointer provided.
+ */
+filter_enu_return_state_t FILTER_chainRun (filter_str_stage_t *ptr_str_arr_stages, uint8_t copy_u8_count, sint16_t copy_s16_sample, sint16_t *ptr_s16_output);
+
+
+#endif /* FILTER_INTERFACE_H_ */
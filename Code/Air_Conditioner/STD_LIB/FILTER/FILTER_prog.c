@@ -0,0 +1,233 @@
+/**
+ * @file FILTER_prog.c
+ * @brief Integer filters for fixed-point sample streams implementation.
+ *
+ * The average keeps the sum of its window and swaps the oldest sample for the newest, the IIR keeps its output
+ * with order extra fractional bits so small steps are not lost to truncation, and the median sorts a copy of its
+ * last samples with a fixed network of compare-exchanges.
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+#include "FILTER_interface.h"
+
+/** @brief Order the two samples so that A <= B */
+#define FILTER_SORT(A,B)				do { if((A) > (B)) { sint16_t s16_swap = (A); (A) = (B); (B) = s16_swap; } } while(0)
+
+/**
+ * @brief Fill the history of a stage with its first sample.
+ *
+ * @param[in,out] ptr_str_stage Stage to prime.
+ * @param[in] copy_s16_sample First sample.
+ */
+static void FILTER_prime(filter_str_stage_t *ptr_str_stage, sint16_t copy_s16_sample);
+
+/**
+ * @brief Moving average of a primed stage.
+ *
+ * @param[in,out] ptr_str_stage Primed FILTER_AVERAGE stage.
+ * @param[in] copy_s16_sample Input sample.
+ * @return Rounded mean of the window.
+ */
+static sint16_t FILTER_average(filter_str_stage_t *ptr_str_stage, sint16_t copy_s16_sample);
+
+/**
+ * @brief First-order IIR of a primed stage.
+ *
+ * @param[in,out] ptr_str_stage Primed FILTER_IIR stage.
+ * @param[in] copy_s16_sample Input sample.
+ * @return Rounded output.
+ */
+static sint16_t FILTER_iir(filter_str_stage_t *ptr_str_stage, sint16_t copy_s16_sample);
+
+/**
+ * @brief Median of a primed stage.
+ *
+ * @param[in,out] ptr_str_stage Primed FILTER_MEDIAN stage.
+ * @param[in] copy_s16_sample Input sample.
+ * @return Median of the last 3 or 5 samples.
+ */
+static sint16_t FILTER_median(filter_str_stage_t *ptr_str_stage, sint16_t copy_s16_sample);
+
+
+filter_enu_return_state_t FILTER_init (filter_str_stage_t *ptr_str_stage, filter_enu_type_t copy_enu_type, uint8_t copy_u8_order)
+{
+	filter_enu_return_state_t enu_return_state = FILTER_E_OK;
+	if(ptr_str_stage == NULL)
+	{
+		enu_return_state = FILTER_NULL_PTR;
+	}
+	else if(((copy_enu_type == FILTER_AVERAGE) && (copy_u8_order > FILTER_AVG_MAX_BITS)) ||
+			((copy_enu_type == FILTER_IIR) && (copy_u8_order > FILTER_IIR_MAX_SHIFT)) ||
+			((copy_enu_type == FILTER_MEDIAN) && (copy_u8_order != FILTER_MEDIAN_3) && (copy_u8_order != FILTER_MEDIAN_5)) ||
+			(copy_enu_type >= FILTER_TYPE_INVALID))
+	{
+		ptr_str_stage->enu_type = FILTER_TYPE_INVALID;
+		enu_return_state = FILTER_E_NOT_OK;
+	}
+	else
+	{
+		ptr_str_stage->enu_type = copy_enu_type;
+		ptr_str_stage->u8_order = copy_u8_order;
+		ptr_str_stage->u8_primed = FALSE;
+	}
+	return enu_return_state;
+}
+
+filter_enu_return_state_t FILTER_reset (filter_str_stage_t *ptr_str_stage)
+{
+	filter_enu_return_state_t enu_return_state = FILTER_E_OK;
+	if(ptr_str_stage == NULL)
+	{
+		enu_return_state = FILTER_NULL_PTR;
+	}
+	else
+	{
+		ptr_str_stage->u8_primed = FALSE;
+	}
+	return enu_return_state;
+}
+
+filter_enu_return_state_t FILTER_run (filter_str_stage_t *ptr_str_stage, sint16_t copy_s16_sample, sint16_t *ptr_s16_output)
+{
+	filter_enu_return_state_t enu_return_state = FILTER_E_OK;
+	if((ptr_str_stage == NULL) || (ptr_s16_output == NULL))
+	{
+		enu_return_state = FILTER_NULL_PTR;
+	}
+	else if(ptr_str_stage->enu_type >= FILTER_TYPE_INVALID)
+	{
+		enu_return_state = FILTER_E_NOT_OK;
+	}
+	else
+	{
+		if(ptr_str_stage->u8_primed == FALSE)
+		{
+			FILTER_prime(ptr_str_stage, copy_s16_sample);
+		}
+		
+		if(ptr_str_stage->enu_type == FILTER_AVERAGE)
+		{
+			*ptr_s16_output = FILTER_average(ptr_str_stage, copy_s16_sample);
+		}
+		else if(ptr_str_stage->enu_type == FILTER_IIR)
+		{
+			*ptr_s16_output = FILTER_iir(ptr_str_stage, copy_s16_sample);
+		}
+		else
+		{
+			*ptr_s16_output = FILTER_median(ptr_str_stage, copy_s16_sample);
+		}
+	}
+	return enu_return_state;
+}
+
+filter_enu_return_state_t FILTER_chainRun (filter_str_stage_t *ptr_str_arr_stages, uint8_t copy_u8_count, sint16_t copy_s16_sample, sint16_t *ptr_s16_output)
+{
+	filter_enu_return_state_t enu_return_state = FILTER_E_OK;
+	uint8_t u8_index;
+	if((ptr_str_arr_stages == NULL) || (ptr_s16_output == NULL))
+	{
+		enu_return_state = FILTER_NULL_PTR;
+	}
+	else
+	{
+		for(u8_index = U8_ZERO_VALUE; (u8_index < copy_u8_count) && (enu_return_state == FILTER_E_OK); u8_index++)
+		{
+			enu_return_state = FILTER_run(&ptr_str_arr_stages[u8_index], copy_s16_sample, &copy_s16_sample);
+		}
+		*ptr_s16_output = copy_s16_sample;
+	}
+	return enu_return_state;
+}
+
+static void FILTER_prime(filter_str_stage_t *ptr_str_stage, sint16_t copy_s16_sample)
+{
+	uint8_t u8_index;
+	uint8_t u8_length = ptr_str_stage->u8_order;
+	
+	if(ptr_str_stage->enu_type == FILTER_AVERAGE)
+	{
+		u8_length = (uint8_t)(U8_ONE_VALUE << ptr_str_stage->u8_order);
+	}
+	else if(ptr_str_stage->enu_type == FILTER_IIR)
+	{
+		u8_length = U8_ZERO_VALUE;
+	}
+	else
+	{
+		//median, one slot per sample
+	}
+	for(u8_index = U8_ZERO_VALUE; u8_index < u8_length; u8_index++)
+	{
+		ptr_str_stage->arr_s16_history[u8_index] = copy_s16_sample;
+	}
+	/* the sum of a full window and the scaled IIR state are both the sample times 2^order */
+	ptr_str_stage->s32_acc = (sint32_t)((uint32_t)(sint32_t)copy_s16_sample << ptr_str_stage->u8_order);
+	ptr_str_stage->u8_index = U8_ZERO_VALUE;
+	ptr_str_stage->u8_primed = TRUE;
+}
+
+static sint16_t FILTER_average(filter_str_stage_t *ptr_str_stage, sint16_t copy_s16_sample)
+{
+	uint8_t u8_index = ptr_str_stage->u8_index;
+	
+	ptr_str_stage->s32_acc += (sint32_t)copy_s16_sample - ptr_str_stage->arr_s16_history[u8_index];
+	ptr_str_stage->arr_s16_history[u8_index] = copy_s16_sample;
+	ptr_str_stage->u8_index = (uint8_t)((u8_index + U8_ONE_VALUE) & ((U8_ONE_VALUE << ptr_str_stage->u8_order) - U8_ONE_VALUE));
+	
+	return (sint16_t)((ptr_str_stage->s32_acc + (((sint32_t)U8_ONE_VALUE << ptr_str_stage->u8_order) >> U8_ONE_VALUE)) >> ptr_str_stage->u8_order);
+}
+
+static sint16_t FILTER_iir(filter_str_stage_t *ptr_str_stage, sint16_t copy_s16_sample)
+{
+	/* state = y * 2^order, so state += x - y is y += (x - y) / 2^order */
+	ptr_str_stage->s32_acc += (sint32_t)copy_s16_sample - (ptr_str_stage->s32_acc >> ptr_str_stage->u8_order);
+	
+	return (sint16_t)((ptr_str_stage->s32_acc + (((sint32_t)U8_ONE_VALUE << ptr_str_stage->u8_order) >> U8_ONE_VALUE)) >> ptr_str_stage->u8_order);
+}
+
+static sint16_t FILTER_median(filter_str_stage_t *ptr_str_stage, sint16_t copy_s16_sample)
+{
+	sint16_t *ptr_s16_history = ptr_str_stage->arr_s16_history;
+	sint16_t s16_a;
+	sint16_t s16_b;
+	sint16_t s16_c;
+	sint16_t s16_d;
+	sint16_t s16_e;
+	sint16_t s16_median;
+	
+	ptr_s16_history[ptr_str_stage->u8_index] = copy_s16_sample;
+	ptr_str_stage->u8_index++;
+	if(ptr_str_stage->u8_index >= ptr_str_stage->u8_order)
+	{
+		ptr_str_stage->u8_index = U8_ZERO_VALUE;
+	}
+	
+	s16_a = ptr_s16_history[0];
+	s16_b = ptr_s16_history[1];
+	s16_c = ptr_s16_history[2];
+	if(ptr_str_stage->u8_order == FILTER_MEDIAN_3)
+	{
+		FILTER_SORT(s16_a, s16_b);
+		FILTER_SORT(s16_b, s16_c);
+		FILTER_SORT(s16_a, s16_b);
+		s16_median = s16_b;
+	}
+	else
+	{
+		/* 7 compare-exchanges leave the median of five in the middle */
+		s16_d = ptr_s16_history[3];
+		s16_e = ptr_s16_history[4];
+		FILTER_SORT(s16_a, s16_b);
+		FILTER_SORT(s16_d, s16_e);
+		FILTER_SORT(s16_a, s16_d);
+		FILTER_SORT(s16_b, s16_e);
+		FILTER_SORT(s16_b, s16_c);
+		FILTER_SORT(s16_c, s16_d);
+		FILTER_SORT(s16_b, s16_c);
+		s16_median = s16_c;
+	}
+	return s16_median;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file FORMAT_interface.h
+ * @brief Division-free number formatting.
+ *
+ * This file declares functions that turn unsigned, signed and Q-format fixed-point values into right-aligned
+ * decimal strings. Digits are extracted with a reciprocal multiply, so no call reaches the software divider.
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+#ifndef FORMAT_INTERFACE_H_
+#define FORMAT_INTERFACE_H_
+
+#include "../bit_math.h"
+
+/** @brief Widest field a format function produces, in characters */
+#define FORMAT_MAX_WIDTH				15
+
+/** @brief Size of a buffer that holds any formatted value and its NULL termination */
+#define FORMAT_BUFFER_SIZE				(FORMAT_MAX_WIDTH + 1)
+
+/** @brief Most digits after the decimal point of a fixed-point value */
+#define FORMAT_MAX_DECIMALS				4
+
+/** @brief Most fractional bits of a Q-format value */
+#define FORMAT_MAX_FRAC_BITS			15
+
+/** @brief Pad character for right-aligned fields */
+#define FORMAT_PAD_SPACE				' '
+
+/** @brief Pad character for zero-filled fields, placed after the sign */
+#define FORMAT_PAD_ZERO					'0'
+
+/**
+ * @brief Enumeration for format module return states.
+ *
+ * FORMAT_E_OK (operation successful), FORMAT_E_NOT_OK (invalid width, decimals or fractional bits) and
+ * FORMAT_NULL_PTR (NULL pointer provided).
+ */
+typedef enum {
+	FORMAT_E_OK,		/**< Operation successful. */
+	FORMAT_E_NOT_OK,	/**< Invalid width, decimals or fractional bits. */
+	FORMAT_NULL_PTR		/**< NULL pointer provided. */
+} format_enu_return_state_t;
+
+/**
+ * @brief Format an unsigned 8-bit value.
+ *
+ * The value is right-aligned in at least copy_u8_width characters; a longer number is never cut.
+ *
+ * @param[in] copy_u8_value Value to format.
+ * @param[in] copy_u8_width Minimum field width, 0 .. FORMAT_MAX_WIDTH.
+ * @param[in] copy_u8_pad Pad character, FORMAT_PAD_SPACE or FORMAT_PAD_ZERO.
+ * @param[out] ptr_u8_buffer Buffer of at least FORMAT_BUFFER_SIZE bytes, NULL terminated on return.
+ * @return Operation status: FORMAT_E_OK if successful, FORMAT_E_NOT_OK if the width is too large, FORMAT_NULL_PTR if NULL pointer provided.
+ */
+format_enu_return_state_t FORMAT_u8 (uint8_t copy_u8_value, uint8_t copy_u8_width, uint8_t copy_u8_pad, uint8_t *ptr_u8_buffer);
+
+/**
+ * @brief Format an unsigned 16-bit value.
+ *
+ * @param[in] copy_u16_value Value to format.
+ * @param[in] copy_u8_width Minimum field width, 0 .. FORMAT_MAX_WIDTH.
+ * @param[in] copy_u8_pad Pad character, FORMAT_PAD_SPACE or FORMAT_PAD_ZERO.
+ * @param[out] ptr_u8_buffer Buffer of at least FORMAT_BUFFER_SIZE bytes, NULL terminated on return.
+ * @return Operation status: FORMAT_E_OK if successful, FORMAT_E_NOT_OK if the width is too large, FORMAT_NULL_PTR if NULL pointer provided.
+ */
+format_enu_return_state_t FORMAT_u16 (uint16_t copy_u16_value, uint8_t copy_u8_width, uint8_t copy_u8_pad, uint8_t *ptr_u8_buffer);
+
+/**
+ * @brief Format a signed 16-bit value.
+ *
+ * Negative values get a leading '-'; with FORMAT_PAD_ZERO the zeros go between the sign and the digits.
+ *
+ * @param[in] copy_s16_value Value to format.
+ * @param[in] copy_u8_width Minimum field width including the sign, 0 .. FORMAT_MAX_WIDTH.
+ * @param[in] copy_u8_pad Pad character, FORMAT_PAD_SPACE or FORMAT_PAD_ZERO.
+ * @param[out] ptr_u8_buffer Buffer of at least FORMAT_BUFFER_SIZE bytes, NULL terminated on return.
+ * @return Operation status: FORMAT_E_OK if successful, FORMAT_E_NOT_OK if the width is too large, FORMAT_NULL_PTR if NULL pointer provided.
+ */
+format_enu_return_state_t FORMAT_s16 (sint16_t copy_s16_value, uint8_t copy_u8_width, uint8_t copy_u8_pad, uint8_t *ptr_u8_buffer);
+
+/**
+ * @brief Format a signed Q-format fixed-point value with a fixed number of decimals.
+ *
+ * The value is copy_s16_value / 2^copy_u8_frac_bits, rounded to the nearest last decimal. Q8.8 23.7 (0x17B3)
+ * with 1 decimal gives "23.7".
+ *
+ * @param[in] copy_s16_value Raw fixed-point value.
+ * @param[in] copy_u8_frac_bits Number of fractional bits, 0 .. FORMAT_MAX_FRAC_BITS.
+ * @param[in] copy_u8_decimals Digits after the decimal point, 0 .. FORMAT_MAX_DECIMALS. 0 prints no point.
+ * @param[in] copy_u8_width Minimum field width including sign and point, 0 .. FORMAT_MAX_WIDTH.
+ * @param[in] copy_u8_pad Pad character, FORMAT_PAD_SPACE or FORMAT_PAD_ZERO.
+ * @param[out] ptr_u8_buffer Buffer of at least FORMAT_BUFFER_SIZE bytes, NULL terminated on return.
+ * @return Operation status: FORMAT_E_OK if successful, FORMAT_E_NOT_OK if an argument is out of range, FORMAT_NULL_PTR if NULL pointer provided.
+ */
+format_enu_return_state_t FORMAT_q16 (sint16_t copy_s16_value, uint8_t copy_u8_frac_bits, uint8_t copy_u8_decimals, uint8_t copy_u8_width, uint8_t copy_u8_pad, uint8_t *ptr_u8_buffer);
+
+
+#endif /* FORMAT_INTERFACE_H_ */
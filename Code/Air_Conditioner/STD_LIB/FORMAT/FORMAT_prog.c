@@ -0,0 +1,214 @@
+/**
+ * @file FORMAT_prog.c
+ * @brief Division-free number formatting implementation.
+ *
+ * Every digit is taken with q = n / 10 computed as a multiply and a shift, and r = n - 10q computed with
+ * shifts and adds. The 16-bit kernel drops to the 8-bit one as soon as the remaining value fits in a byte.
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+#include "FORMAT_interface.h"
+
+/** @brief n / 10 == (n * 205) >> 11 for every 8-bit n */
+#define FORMAT_U8_DIV10_MUL				205U
+#define FORMAT_U8_DIV10_SHIFT			11
+
+/** @brief n / 10 == (n * 0xCCCD) >> 19 for every 16-bit n */
+#define FORMAT_U16_DIV10_MUL			0xCCCDUL
+#define FORMAT_U16_DIV10_SHIFT			19
+
+/** @brief Digits of the largest 16-bit value */
+#define FORMAT_U16_DIGITS_MAX			5
+
+/** @brief Character of digit 0 */
+#define FORMAT_0_CHAR					'0'
+
+/** @brief Sign of a negative value */
+#define FORMAT_MINUS_CHAR				'-'
+
+/** @brief Decimal point */
+#define FORMAT_POINT_CHAR				'.'
+
+/**
+ * @brief Powers of ten for the fraction scaling, indexed by the number of decimals.
+ */
+static const uint16_t gs_u16_arr_pow10[FORMAT_MAX_DECIMALS + 1] = {1, 10, 100, 1000, 10000};
+
+/**
+ * @brief Extract the decimal digits of a value, least significant first.
+ *
+ * @param[in] copy_u16_value Value to convert.
+ * @param[in] copy_u8_min_digits Digits to produce at least, leading zeros included.
+ * @param[out] ptr_u8_digits Digit characters, least significant first.
+ * @return Number of digits written.
+ */
+static uint8_t FORMAT_digits(uint16_t copy_u16_value, uint8_t copy_u8_min_digits, uint8_t *ptr_u8_digits);
+
+/**
+ * @brief Lay out sign, padding, integer digits and fraction digits into the caller buffer.
+ *
+ * @param[in] copy_u8_negative TRUE to print a leading '-'.
+ * @param[in] copy_u16_int Integer part.
+ * @param[in] copy_u16_frac Fraction part, already scaled to copy_u8_decimals digits.
+ * @param[in] copy_u8_decimals Digits after the decimal point, 0 for none.
+ * @param[in] copy_u8_width Minimum field width.
+ * @param[in] copy_u8_pad Pad character.
+ * @param[out] ptr_u8_buffer Destination buffer.
+ * @return Operation status: FORMAT_E_OK if successful, FORMAT_E_NOT_OK if the width is too large, FORMAT_NULL_PTR if NULL pointer provided.
+ */
+static format_enu_return_state_t FORMAT_emit(uint8_t copy_u8_negative, uint16_t copy_u16_int, uint16_t copy_u16_frac, uint8_t copy_u8_decimals, uint8_t copy_u8_width, uint8_t copy_u8_pad, uint8_t *ptr_u8_buffer);
+
+
+format_enu_return_state_t FORMAT_u8 (uint8_t copy_u8_value, uint8_t copy_u8_width, uint8_t copy_u8_pad, uint8_t *ptr_u8_buffer)
+{
+	return FORMAT_emit(FALSE, copy_u8_value, U8_ZERO_VALUE, U8_ZERO_VALUE, copy_u8_width, copy_u8_pad, ptr_u8_buffer);
+}
+
+format_enu_return_state_t FORMAT_u16 (uint16_t copy_u16_value, uint8_t copy_u8_width, uint8_t copy_u8_pad, uint8_t *ptr_u8_buffer)
+{
+	return FORMAT_emit(FALSE, copy_u16_value, U8_ZERO_VALUE, U8_ZERO_VALUE, copy_u8_width, copy_u8_pad, ptr_u8_buffer);
+}
+
+format_enu_return_state_t FORMAT_s16 (sint16_t copy_s16_value, uint8_t copy_u8_width, uint8_t copy_u8_pad, uint8_t *ptr_u8_buffer)
+{
+	format_enu_return_state_t enu_return_state;
+	if(copy_s16_value < 0)
+	{
+		/* the magnitude of -32768 still fits in 16 unsigned bits */
+		enu_return_state = FORMAT_emit(TRUE, (uint16_t)(U8_ZERO_VALUE - (uint16_t)copy_s16_value), U8_ZERO_VALUE, U8_ZERO_VALUE, copy_u8_width, copy_u8_pad, ptr_u8_buffer);
+	}
+	else
+	{
+		enu_return_state = FORMAT_emit(FALSE, (uint16_t)copy_s16_value, U8_ZERO_VALUE, U8_ZERO_VALUE, copy_u8_width, copy_u8_pad, ptr_u8_buffer);
+	}
+	return enu_return_state;
+}
+
+format_enu_return_state_t FORMAT_q16 (sint16_t copy_s16_value, uint8_t copy_u8_frac_bits, uint8_t copy_u8_decimals, uint8_t copy_u8_width, uint8_t copy_u8_pad, uint8_t *ptr_u8_buffer)
+{
+	format_enu_return_state_t enu_return_state;
+	uint8_t u8_negative = FALSE;
+	uint16_t u16_magnitude = (uint16_t)copy_s16_value;
+	uint16_t u16_int;
+	uint32_t u32_frac;
+	if((copy_u8_frac_bits > FORMAT_MAX_FRAC_BITS) || (copy_u8_decimals > FORMAT_MAX_DECIMALS))
+	{
+		enu_return_state = FORMAT_E_NOT_OK;
+	}
+	else
+	{
+		if(copy_s16_value < 0)
+		{
+			u8_negative = TRUE;
+			u16_magnitude = (uint16_t)(U8_ZERO_VALUE - u16_magnitude);
+		}
+		u16_int = u16_magnitude >> copy_u8_frac_bits;
+		u32_frac = u16_magnitude & (uint16_t)(((uint16_t)U8_ONE_VALUE << copy_u8_frac_bits) - U8_ONE_VALUE);
+
+		/* frac / 2^bits * 10^decimals, rounded half up: one multiply, one add, one shift */
+		u32_frac *= gs_u16_arr_pow10[copy_u8_decimals];
+		if(copy_u8_frac_bits > U8_ZERO_VALUE)
+		{
+			u32_frac = (u32_frac + ((uint32_t)U8_ONE_VALUE << (copy_u8_frac_bits - U8_ONE_VALUE))) >> copy_u8_frac_bits;
+		}
+		if(u32_frac >= gs_u16_arr_pow10[copy_u8_decimals])
+		{
+			/* rounding carried into the integer part, e.g. 23.96 with 1 decimal */
+			u32_frac -= gs_u16_arr_pow10[copy_u8_decimals];
+			u16_int++;
+		}
+		if((u16_int == U8_ZERO_VALUE) && (u32_frac == U8_ZERO_VALUE))
+		{
+			/* no "-0.0" */
+			u8_negative = FALSE;
+		}
+		enu_return_state = FORMAT_emit(u8_negative, u16_int, (uint16_t)u32_frac, copy_u8_decimals, copy_u8_width, copy_u8_pad, ptr_u8_buffer);
+	}
+	return enu_return_state;
+}
+
+static uint8_t FORMAT_digits(uint16_t copy_u16_value, uint8_t copy_u8_min_digits, uint8_t *ptr_u8_digits)
+{
+	uint8_t u8_count = U8_ZERO_VALUE;
+	uint16_t u16_quotient;
+	uint8_t u8_value;
+	uint8_t u8_quotient;
+
+	while(copy_u16_value > U8_BIT_REG_MASK)
+	{
+		u16_quotient = (uint16_t)((copy_u16_value * FORMAT_U16_DIV10_MUL) >> FORMAT_U16_DIV10_SHIFT);
+		ptr_u8_digits[u8_count] = FORMAT_0_CHAR + (uint8_t)(copy_u16_value - ((u16_quotient << 3) + (u16_quotient << 1)));
+		copy_u16_value = u16_quotient;
+		u8_count++;
+	}
+
+	u8_value = (uint8_t)copy_u16_value;
+	do
+	{
+		u8_quotient = (uint8_t)(((uint16_t)u8_value * FORMAT_U8_DIV10_MUL) >> FORMAT_U8_DIV10_SHIFT);
+		ptr_u8_digits[u8_count] = FORMAT_0_CHAR + (uint8_t)(u8_value - ((u8_quotient << 3) + (u8_quotient << 1)));
+		u8_value = u8_quotient;
+		u8_count++;
+	} while((u8_value != U8_ZERO_VALUE) || (u8_count < copy_u8_min_digits));
+
+	return u8_count;
+}
+
+static format_enu_return_state_t FORMAT_emit(uint8_t copy_u8_negative, uint16_t copy_u16_int, uint16_t copy_u16_frac, uint8_t copy_u8_decimals, uint8_t copy_u8_width, uint8_t copy_u8_pad, uint8_t *ptr_u8_buffer)
+{
+	format_enu_return_state_t enu_return_state = FORMAT_E_OK;
+	uint8_t u8_arr_int[FORMAT_U16_DIGITS_MAX];
+	uint8_t u8_arr_frac[FORMAT_MAX_DECIMALS];
+	uint8_t u8_int_digits;
+	uint8_t u8_length;
+	uint8_t u8_index = U8_ZERO_VALUE;
+	if(ptr_u8_buffer == NULL)
+	{
+		enu_return_state = FORMAT_NULL_PTR;
+	}
+	else if(copy_u8_width > FORMAT_MAX_WIDTH)
+	{
+		enu_return_state = FORMAT_E_NOT_OK;
+	}
+	else
+	{
+		u8_int_digits = FORMAT_digits(copy_u16_int, U8_ONE_VALUE, u8_arr_int);
+		u8_length = u8_int_digits + copy_u8_negative;
+		if(copy_u8_decimals > U8_ZERO_VALUE)
+		{
+			FORMAT_digits(copy_u16_frac, copy_u8_decimals, u8_arr_frac);
+			u8_length += copy_u8_decimals + U8_ONE_VALUE;
+		}
+
+		if((copy_u8_negative == TRUE) && (copy_u8_pad == FORMAT_PAD_ZERO))
+		{
+			ptr_u8_buffer[u8_index++] = FORMAT_MINUS_CHAR;
+		}
+		for(; u8_length < copy_u8_width; u8_length++)
+		{
+			ptr_u8_buffer[u8_index++] = copy_u8_pad;
+		}
+		if((copy_u8_negative == TRUE) && (copy_u8_pad != FORMAT_PAD_ZERO))
+		{
+			ptr_u8_buffer[u8_index++] = FORMAT_MINUS_CHAR;
+		}
+		while(u8_int_digits > U8_ZERO_VALUE)
+		{
+			u8_int_digits--;
+			ptr_u8_buffer[u8_index++] = u8_arr_int[u8_int_digits];
+		}
+		if(copy_u8_decimals > U8_ZERO_VALUE)
+		{
+			ptr_u8_buffer[u8_index++] = FORMAT_POINT_CHAR;
+			while(copy_u8_decimals > U8_ZERO_VALUE)
+			{
+				copy_u8_decimals--;
+				ptr_u8_buffer[u8_index++] = u8_arr_frac[copy_u8_decimals];
+			}
+		}
+		ptr_u8_buffer[u8_index] = '\0';
+	}
+	return enu_return_state;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file format_check.c
+ * @brief Host check of the FORMAT library against printf.
+ *
+ * Formats every u8, u16 and s16 value in field widths 0 .. 7 with both pad characters and compares the result
+ * with snprintf. FORMAT_q16 is checked for every s16 raw value, every number of fractional bits and decimals,
+ * against an exact integer reference that rounds half away from zero, and with arguments out of range.
+ * Runs on the build machine, not on the target:
+ *
+ * @code{.sh}
+ * cd Code
+ * gcc -std=gnu99 -Wall -o format_check tools/format_check.c Air_Conditioner/STD_LIB/FORMAT/FORMAT_prog.c
+ * ./format_check
+ * @endcode
+ *
+ * @date 2026-10-16
+ * @author agent
+ */
+
+#include <stdio.h>
+#include <string.h>
+#undef NULL
+#include "../Air_Conditioner/STD_LIB/FORMAT/FORMAT_interface.h"
+
+/** @brief Widest field the check runs through */
+#define CHECK_WIDTH_MAX			7
+
+/** @brief Mismatches printed before the check stops reporting them */
+#define CHECK_REPORT_MAX		10
+
+/** @brief Size of the reference buffers, larger than any reference output */
+#define CHECK_REFERENCE_SIZE	64
+
+/** @brief Field widths of the FORMAT_q16 sweep: none, the temperature readout, a padded field */
+static const uint8_t gs_u8_arr_q16Widths[] = {0, 4, CHECK_WIDTH_MAX};
+
+static unsigned long gs_u32_failures = 0;
+
+/**
+ * @brief Compare a formatted value with the printf reference and report a mismatch.
+ *
+ * @param[in] ptr_u8_result Output of the FORMAT function.
+ * @param[in] ptr_c_expected Output of snprintf.
+ * @param[in] ptr_c_name Name of the FORMAT function.
+ * @param[in] s32_value Formatted value.
+ * @param[in] u8_width Field width.
+ * @param[in] u8_pad Pad character.
+ */
+static void check(const uint8_t *ptr_u8_result, const char *ptr_c_expected, const char *ptr_c_name, long s32_value, uint8_t u8_width, uint8_t u8_pad)
+{
+	const char *ptr_c_result = (const char *)ptr_u8_result;
+	unsigned int u16_index = 0;
+
+	while((ptr_c_result[u16_index] == ptr_c_expected[u16_index]) && (ptr_c_expected[u16_index] != '\0'))
+	{
+		u16_index++;
+	}
+	if(ptr_c_result[u16_index] != ptr_c_expected[u16_index])
+	{
+		if(gs_u32_failures < CHECK_REPORT_MAX)
+		{
+			printf("%s(%ld, %u, '%c'): \"%s\", expected \"%s\"\n", ptr_c_name, s32_value, u8_width, u8_pad, ptr_c_result, ptr_c_expected);
+		}
+		gs_u32_failures++;
+	}
+}
+
+/**
+ * @brief Reference of FORMAT_q16: the exact quotient rounded half away from zero, printed with snprintf.
+ *
+ * @param[out] ptr_c_expected Buffer of CHECK_REFERENCE_SIZE bytes.
+ * @param[in] s32_value Raw fixed-point value.
+ * @param[in] u8_frac_bits Number of fractional bits.
+ * @param[in] u8_decimals Digits after the decimal point.
+ * @param[in] u8_width Field width.
+ * @param[in] u8_pad Pad character.
+ */
+static void reference_q16(char *ptr_c_expected, long s32_value, uint8_t u8_frac_bits, uint8_t u8_decimals, uint8_t u8_width, uint8_t u8_pad)
+{
+	unsigned long long u64_scale = 1;
+	unsigned long long u64_magnitude = (s32_value < 0) ? (unsigned long long)(-s32_value) : (unsigned long long)s32_value;
+	unsigned long long u64_rounded;
+	char c_arr_digits[CHECK_REFERENCE_SIZE];
+	size_t u32_length;
+	size_t u32_index = 0;
+	uint8_t u8_negative;
+
+	for(uint8_t u8_index = 0; u8_index < u8_decimals; u8_index++)
+	{
+		u64_scale *= 10;
+	}
+	/* floor(magnitude * 10^decimals / 2^bits + 1/2) */
+	u64_rounded = ((u64_magnitude * u64_scale * 2) + (1ULL << u8_frac_bits)) >> (u8_frac_bits + 1);
+
+	/* integer part, then the point and the decimals with their leading zeros */
+	snprintf(c_arr_digits, sizeof(c_arr_digits), "%llu", u64_rounded / u64_scale);
+	u32_length = strlen(c_arr_digits);
+	if(u8_decimals > 0)
+	{
+		c_arr_digits[u32_length + u8_decimals + 1] = '\0';
+		for(uint8_t u8_index = u8_decimals; u8_index > 0; u8_index--)
+		{
+			c_arr_digits[u32_length + u8_index] = (char)('0' + (u64_rounded % 10));
+			u64_rounded /= 10;
+		}
+		c_arr_digits[u32_length] = '.';
+		u32_length += u8_decimals + 1;
+	}
+
+	/* a value that rounds to zero has no sign */
+	u8_negative = (s32_value < 0) && (strspn(c_arr_digits, "0.") != u32_length);
+	if(u8_negative)
+	{
+		u32_length++;
+	}
+	if(u8_pad == FORMAT_PAD_SPACE)
+	{
+		for(; u32_length < u8_width; u32_length++)
+		{
+			ptr_c_expected[u32_index++] = ' ';
+		}
+	}
+	if(u8_negative)
+	{
+		ptr_c_expected[u32_index++] = '-';
+	}
+	for(; u32_length < u8_width; u32_length++)
+	{
+		ptr_c_expected[u32_index++] = '0';
+	}
+	strcpy(&ptr_c_expected[u32_index], c_arr_digits);
+}
+
+/**
+ * @brief Report a FORMAT_q16 call with arguments out of range that was not refused.
+ *
+ * @param[in] u8_frac_bits Number of fractional bits.
+ * @param[in] u8_decimals Digits after the decimal point.
+ * @param[in] u8_width Field width.
+ */
+static void check_q16_refused(uint8_t u8_frac_bits, uint8_t u8_decimals, uint8_t u8_width)
+{
+	uint8_t u8_arr_result[FORMAT_BUFFER_SIZE];
+
+	if(FORMAT_q16(1, u8_frac_bits, u8_decimals, u8_width, FORMAT_PAD_SPACE, u8_arr_result) != FORMAT_E_NOT_OK)
+	{
+		printf("FORMAT_q16 accepted %u fractional bits, %u decimals, width %u\n", u8_frac_bits, u8_decimals, u8_width);
+		gs_u32_failures++;
+	}
+}
+
+int main(void)
+{
+	uint8_t u8_arr_result[FORMAT_BUFFER_SIZE];
+	char c_arr_expected[CHECK_REFERENCE_SIZE];
+	char c_arr_name[CHECK_REFERENCE_SIZE];
+	const uint8_t u8_arr_pads[] = {FORMAT_PAD_SPACE, FORMAT_PAD_ZERO};
+	uint8_t u8_pad;
+
+	for(uint8_t u8_width = 0; u8_width <= CHECK_WIDTH_MAX; u8_width++)
+	{
+		for(uint8_t u8_pad_index = 0; u8_pad_index < sizeof(u8_arr_pads); u8_pad_index++)
+		{
+			u8_pad = u8_arr_pads[u8_pad_index];
+			for(long s32_value = 0; s32_value <= 0xFF; s32_value++)
+			{
+				FORMAT_u8((uint8_t)s32_value, u8_width, u8_pad, u8_arr_result);
+				snprintf(c_arr_expected, sizeof(c_arr_expected), (u8_pad == FORMAT_PAD_ZERO) ? "%0*ld" : "%*ld", u8_width, s32_value);
+				check(u8_arr_result, c_arr_expected, "FORMAT_u8", s32_value, u8_width, u8_pad);
+			}
+			for(long s32_value = 0; s32_value <= 0xFFFF; s32_value++)
+			{
+				FORMAT_u16((uint16_t)s32_value, u8_width, u8_pad, u8_arr_result);
+				snprintf(c_arr_expected, sizeof(c_arr_expected), (u8_pad == FORMAT_PAD_ZERO) ? "%0*ld" : "%*ld", u8_width, s32_value);
+				check(u8_arr_result, c_arr_expected, "FORMAT_u16", s32_value, u8_width, u8_pad);
+			}
+			for(long s32_value = -32768; s32_value <= 32767; s32_value++)
+			{
+				FORMAT_s16((sint16_t)s32_value, u8_width, u8_pad, u8_arr_result);
+				snprintf(c_arr_expected, sizeof(c_arr_expected), (u8_pad == FORMAT_PAD_ZERO) ? "%0*ld" : "%*ld", u8_width, s32_value);
+				check(u8_arr_result, c_arr_expected, "FORMAT_s16", s32_value, u8_width, u8_pad);
+			}
+		}
+	}
+
+	for(uint8_t u8_frac_bits = 0; u8_frac_bits <= FORMAT_MAX_FRAC_BITS; u8_frac_bits++)
+	{
+		for(uint8_t u8_decimals = 0; u8_decimals <= FORMAT_MAX_DECIMALS; u8_decimals++)
+		{
+			snprintf(c_arr_name, sizeof(c_arr_name), "FORMAT_q16 Q.%u %u decimals", u8_frac_bits, u8_decimals);
+			for(uint8_t u8_width_index = 0; u8_width_index < sizeof(gs_u8_arr_q16Widths); u8_width_index++)
+			{
+				for(uint8_t u8_pad_index = 0; u8_pad_index < sizeof(u8_arr_pads); u8_pad_index++)
+				{
+					u8_pad = u8_arr_pads[u8_pad_index];
+					for(long s32_value = -32768; s32_value <= 32767; s32_value++)
+					{
+						FORMAT_q16((sint16_t)s32_value, u8_frac_bits, u8_decimals, gs_u8_arr_q16Widths[u8_width_index], u8_pad, u8_arr_result);
+						reference_q16(c_arr_expected, s32_value, u8_frac_bits, u8_decimals, gs_u8_arr_q16Widths[u8_width_index], u8_pad);
+						check(u8_arr_result, c_arr_expected, c_arr_name, s32_value, gs_u8_arr_q16Widths[u8_width_index], u8_pad);
+					}
+				}
+			}
+		}
+	}
+	check_q16_refused(FORMAT_MAX_FRAC_BITS + 1, 1, 0);
+	check_q16_refused(8, FORMAT_MAX_DECIMALS + 1, 0);
+	check_q16_refused(8, 1, FORMAT_MAX_WIDTH + 1);
+
+	printf("%lu mismatches\n", gs_u32_failures);
+	return (gs_u32_failures == 0) ? 0 : 1;
+}